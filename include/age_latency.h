@@ -9,10 +9,60 @@
 #define SRC_INCLUDE_AGE_LATENCY_H_
 
 #include <model.h>
+#include <partial_constraint_graph.h>
+#include <model_analysis_context.h>
+#include <graph_reduction.h>
+#include <refinement_strategy.h>
+#include <instrumentation.h>
 #include <numeric>
 
 #define VERBOSE_AGE_LATENCY(m) VERBOSE_CUSTOM_DEBUG("AGE_LATENCY", m)
 
+/**
+ * What ComputeAgeLatency does on top of the expansion and the longest path.
+ * The default is the production mode, checked() is the former SUPERDBG behaviour.
+ */
+struct AgeLatencyOptions {
+	bool verify_reference    = false; // check every iteration against generate_partial_constraint_graph
+	bool compute_lower_bound = false; // solve generate_partial_lowerbound_graph every iteration (fills lower_bounds)
+	bool collect_statistics  = true;  // fill the per-iteration vectors of AgeLatencyResult
+	bool stop_on_bound_gap   = false; // solve the lower bound graph too, stop once the best lower bound reaches the upper bound
+	bool concurrent_bounds   = true;  // when a lower bound is needed, solve it on a second thread during the engine call
+	double time_budget       = 0;     // ms, no new iteration starts past it, 0 for no budget
+	size_t max_iterations    = 0;     // no new iteration starts past it, 0 for no cap
+	double epsilon           = 0;     // stop once best upper - best lower <= epsilon * best upper, 0 to wait for exactness
+	RefinementStrategy refinement;    // how K is chosen, the critical path rule alone by default
+	size_t speculative_threads = 1;   // threads evaluating the candidates of a refinement, the engine must then be reentrant
+	PeriodicityVector warm_start_K;   // final K of a previous analysis of a close model, empty for a cold start
+	std::vector<Execution> warm_start_path; // its critical path, tasks of the path get lcm(K[t], N_P[t]) as well
+
+	inline bool is_anytime () const { return time_budget > 0 or max_iterations > 0 or epsilon > 0; }
+	inline bool needs_lower_bound () const { return compute_lower_bound or stop_on_bound_gap or is_anytime(); }
+
+	static AgeLatencyOptions production () { return AgeLatencyOptions(); }
+	static AgeLatencyOptions checked () {
+		AgeLatencyOptions options;
+		options.verify_reference = true;
+		options.compute_lower_bound = true;
+		return options;
+	}
+};
+
+/**
+ * How an anytime ComputeAgeLatency ended: age_latency is exact, within epsilon of best_lower_bound,
+ * or the best upper bound found before the time budget or the iteration cap stopped it.
+ */
+enum class AgeLatencyStatus { exact, within_epsilon, truncated };
+
+inline std::ostream &operator<<(std::ostream &stream, const AgeLatencyStatus &status) {
+	switch (status) {
+	case AgeLatencyStatus::exact          : return stream << "exact";
+	case AgeLatencyStatus::within_epsilon : return stream << "within_epsilon";
+	case AgeLatencyStatus::truncated      : return stream << "truncated";
+	}
+	return stream;
+}
+
 struct AgeLatencyResult {
 	size_t n = 0;
 	size_t m = 0;
@@ -20,10 +70,38 @@ struct AgeLatencyResult {
 	TIME_UNIT graph_computation_time = 0.0;
 	TIME_UNIT path_computation_time  = 0.0;
 	INTEGER_TIME_UNIT age_latency = 0;
+	size_t iterations = 0;
+	INTEGER_TIME_UNIT best_lower_bound = 0; // largest lower bound over the iterations when they are solved, age_latency once exact
+	INTEGER_TIME_UNIT best_upper_bound = 0; // smallest upper bound over the iterations
+	bool closed_by_bounds = false; // stopped because best_lower_bound reached the upper bound, or came within epsilon of it
+	AgeLatencyStatus status = AgeLatencyStatus::exact;
+	TIME_UNIT total_time = 0.0; // ms, the whole analysis
+	TIME_UNIT context_setup_time = 0.0; // ms, ModelAnalysisContext built once per analysis
 	std::vector<INTEGER_TIME_UNIT> expansion_vertex_count;
 	std::vector<INTEGER_TIME_UNIT> expansion_edge_count;
 	std::vector<INTEGER_TIME_UNIT> upper_bounds;
 	std::vector<INTEGER_TIME_UNIT> lower_bounds;
+	std::vector<size_t> allocation_count; // graph container allocations of the generation and path search, per iteration
+	std::vector<size_t> reused_dependency_count; // dependencies not re-expanded, per iteration (incremental engine only)
+	std::vector<size_t> candidate_count; // periodicity vectors evaluated, per iteration
+	std::vector<TIME_UNIT> graph_computation_times; // ms, per iteration, summed over the candidates
+	std::vector<TIME_UNIT> path_computation_times; // ms, per iteration, summed over the candidates
+	PeriodicityVector periodicity_vector; // K of the last iteration, the warm_start_K of a next analysis
+	std::vector<Execution> critical_path; // critical path of the last iteration, the warm_start_path of a next analysis
+	TIME_UNIT reduction_time = 0.0; // ms, graph reduction between expansion and path search (reduced engine only)
+	std::vector<INTEGER_TIME_UNIT> reduced_vertex_count; // per iteration, reduced engine only
+	std::vector<INTEGER_TIME_UNIT> reduced_edge_count;
+	InstrumentationCounters instrumentation; // what the expansions did, detailed counters with LETITGO_INSTRUMENTATION only
+
+	/**
+	 * Constraints left by the reduction over constraints of the expansion, 1 without reduction.
+	 */
+	inline double reduction_ratio () const {
+		if (reduced_edge_count.empty()) return 1.0;
+		const double expanded = std::accumulate(expansion_edge_count.begin(), expansion_edge_count.end(), 0.0);
+		const double reduced  = std::accumulate(reduced_edge_count.begin(), reduced_edge_count.end(), 0.0);
+		return expanded ? reduced / expanded : 1.0;
+	}
 
 	AgeLatencyResult () {}
 
@@ -35,20 +113,107 @@ struct AgeLatencyResult {
 	    		<< " graph_computation_time=" << obj.graph_computation_time
 	    		<< " path_computation_time=" << obj.path_computation_time
 	    		<< " age_latency=" << obj.age_latency
-	    		<< " iterations=" << obj.expansion_vertex_count.size()
-	    	    << " ExVSize=" << obj.expansion_vertex_count.back()
-	    		<< " ExESize=" << obj.expansion_edge_count.back()
-	    		 << " first_bound_error=" << obj.lower_bounds.front()
-	           << ">";
+	    		<< " iterations=" << obj.iterations
+	    		<< " status=" << obj.status
+	    		<< " best_lower_bound=" << obj.best_lower_bound
+	    		<< " best_upper_bound=" << obj.best_upper_bound
+	    		<< " closed_by_bounds=" << obj.closed_by_bounds
+	    		<< " total_time=" << obj.total_time
+	    		<< " context_setup_time=" << obj.context_setup_time;
+	    if (obj.expansion_vertex_count.size()) {
+	    	stream << " ExVSize=" << obj.expansion_vertex_count.back()
+	    		   << " ExESize=" << obj.expansion_edge_count.back();
+	    }
+	    if (obj.reduced_edge_count.size()) {
+	    	stream << " reduction_ratio=" << obj.reduction_ratio()
+	    		   << " reduction_time=" << obj.reduction_time;
+	    }
+	    if (obj.lower_bounds.size()) {
+	    	stream << " first_bound_error=" << obj.lower_bounds.front();
+	    }
+	    stream << ">";
 	    return stream;
 	  }
 
 };
 
-typedef std::function<AgeLatencyResult(const LETModel &model, GenerateExpansionFun fun)> AgeLatencyFun;
+typedef std::function<AgeLatencyResult(const LETModel &model, GenerateExpansionFun fun, const AgeLatencyOptions& options)> AgeLatencyFun;
 
+/**
+ * What one iteration of ComputeAgeLatency needs from a K: the critical path
+ * from s to f and its length, plus the size of the expansion that was used.
+ */
+struct CriticalPathResult {
+	std::vector<Execution> path;
+	INTEGER_TIME_UNIT length = 0;
+	size_t vertex_count = 0;
+	size_t edge_count = 0;
+	size_t reused_dependencies = 0;
+	bool reduced = false; // the path search ran on a reduced graph of reduced_*_count
+	size_t reduced_vertex_count = 0;
+	size_t reduced_edge_count = 0;
+	TIME_UNIT graph_computation_time = 0.0;
+	TIME_UNIT path_computation_time  = 0.0;
+	TIME_UNIT reduction_time = 0.0;
+};
 
-AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun fun = generate_partial_constraint_graph) ;
+/**
+ * Engines receive the context ComputeAgeLatencyWithEngine built once for the model,
+ * context.getModel() is the model under analysis.
+ */
+typedef std::function<CriticalPathResult(const ModelAnalysisContext &context, const PeriodicityVector &K)> AgeLatencyEngineFun;
+
+/**
+ * Engine that generates the partial constraint graph with fun then run FindLongestPath on it.
+ * With verify_reference every graph is compared to generate_partial_constraint_graph.
+ */
+AgeLatencyEngineFun expansion_engine (GenerateExpansionFun fun, bool verify_reference = false);
+
+/**
+ * Engine that never builds the constraint graph: tasks are visited in topological order
+ * and the constraints produced by Algorithm 2 are relaxed as they are generated into
+ * one distance array per task. Memory is O(sum K) instead of O(E).
+ * The bound is the one of FindLongestPath, when several paths are critical
+ * the returned one can differ from the path found on the full graph.
+ */
+CriticalPathResult fused_expansion_engine (const ModelAnalysisContext &context, const PeriodicityVector &K);
+
+/**
+ * Engine that sees every dependency as a Ki x Kj max-plus matrix (MaxPlusBlock) and
+ * propagates one distance vector per task in topological order, with tiled SIMD kernels.
+ * No Constraint is ever built. Memory is O(sum K) plus the largest block, so it suits
+ * dense dependencies. Same bound as FindLongestPath, possibly another critical path.
+ */
+CriticalPathResult max_plus_engine (const ModelAnalysisContext &context, const PeriodicityVector &K);
+
+/**
+ * Engine that keeps the constraints of every dependency between two calls, only dependencies
+ * with a source or target task whose K changed are expanded again (as well as their start and
+ * finish constraints). The graph is the one of generate_partial_constraint_graph.
+ * The returned engine owns its state, a new model resets it, still one engine
+ * per ComputeAgeLatencyWithEngine call is the expected usage. Calls are serialized,
+ * speculative candidates evaluated on several threads are expanded one after the other.
+ */
+AgeLatencyEngineFun incremental_expansion_engine ();
+
+/**
+ * Engine that generates the compact graph with fun, reduces it with reduce_constraint_graph
+ * then runs FindLongestPath on the reduced graph. The bound is the one of the expansion,
+ * the path is expanded back to executions of the original graph.
+ */
+AgeLatencyEngineFun reduced_expansion_engine (GenerateCompactExpansionFun fun = generate_compact_constraint_graph, const GraphReductionOptions& options = GraphReductionOptions());
+
+AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun fun = generate_partial_constraint_graph, const AgeLatencyOptions& options = AgeLatencyOptions()) ;
+AgeLatencyResult ComputeAgeLatencyWithEngine(const LETModel &model, AgeLatencyEngineFun engine, const AgeLatencyOptions& options = AgeLatencyOptions()) ;
+
+/**
+ * Analyse every model with fun and the expansion on a work-stealing pool of thread_count threads (0 means one per hardware thread),
+ * the largest sum N first. results[i] is the analysis of models[i] whatever the scheduling, its total_time is the
+ * time the analysis took on its worker. fun is called concurrently, each call must use its own engine.
+ */
+std::vector<AgeLatencyResult> ComputeAgeLatencyBatch(const std::vector<LETModel>& models, const AgeLatencyOptions& options = AgeLatencyOptions(),
+		size_t thread_count = 0, AgeLatencyFun fun = (AgeLatencyFun) ComputeAgeLatency,
+		GenerateExpansionFun expansion = opt_new_generate_partial_constraint_graph) ;
 
 
 
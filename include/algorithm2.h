@@ -0,0 +1,338 @@
+/*
+ * algorithm2.h
+ *
+ *  Created on: Feb 18, 2021
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_ALGORITHM2_H_
+#define INCLUDE_ALGORITHM2_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <partial_constraint_graph.h>
+#include <utils.h>
+#include <integer_arithmetic.h>
+#include <model_analysis_context.h>
+#include <numeric>
+#include <cmath>
+
+#ifndef VERBOSE_NPCG
+#ifdef ULTRA_DEBUG
+#define VERBOSE_NPCG(m) VERBOSE_CUSTOM_DEBUG("NPCG", m)
+#define VERBOSE_ALGO1(stream) VERBOSE_NPCG("   Algorithm 1: " << stream)
+#else
+#define VERBOSE_NPCG(m) {}
+#define VERBOSE_ALGO1(stream) {}
+#endif
+#endif
+
+
+/**
+ * Description of Algorithm 2:
+ *
+ *   g(x,y) = g(0,0) + (y*T_y - x*T_x)/gcd_K
+ *   g(x,y) = f(0,0) + (y*T_y - x*T_x)/gcd_K
+ *
+ *   g(0,0) * gcd_K is INTEGER
+ *   f(0,0) * gcd_K is INTEGER
+ *
+ *   g(0,0) >= f(0,0)
+ *
+ *   The algorithm returns the set S = {(x,y) in {1,..,K_x}*{1,..,K_y}, floor (g(x,y)) >= ceil (f(x,y))
+ *
+ *
+ *   Now in the context of LET:
+ *
+ *   double f0, double g0,
+ *   EXECUTION_COUNT Tx,EXECUTION_COUNT Ty,
+ *   EXECUTION_COUNT gcdk,
+ *   EXECUTION_COUNT maxX, EXECUTION_COUNT maxY
+ *
+ *
+ *
+ */
+
+
+template <typename entier>
+entier opt_extended_euclide (entier _a, entier _b, entier _c) {
+
+	// Kuṭṭaka, Aryabhata's algorithm for solving linear Diophantine equations in two unknowns
+	const entier gcdab = std::gcd(_a,_b) ;
+
+	const entier a = _a/ gcdab;
+	const entier b = _b/ gcdab;
+	const entier c = _c/ gcdab;
+
+	std::pair<entier,entier> r (a,b);
+	std::pair<entier,entier> s (1,0);
+
+    while (r.second != 0) {
+    	const entier quotient = r.first / r.second;
+    	r = std::pair<entier,entier> ( r.second ,  r.first - quotient * r.second );
+    	s = std::pair<entier,entier> ( s.second ,  s.first - quotient * s.second );
+    }
+
+    return c * s.first ;
+
+}
+
+/**
+ * Case of Algorithm 2 new_algorithm2 takes for a dependency, 1 to 3.
+ * f0 * gcdK = gcdT - Me and g0 * gcdK = Ti - Me, so case 1 does not depend on Me.
+ */
+inline size_t algorithm2_case (const Theorem6Kernel& kernel) {
+	if (kernel.Ti >= kernel.gcdK + kernel.gcdT) return 1;
+	if (kernel.Tj == kernel.gcdK) return 2;
+	return 3;
+}
+
+/**
+ * new_algorithm2 is templated over the graph it fills, the only requirement
+ * is a `void add(const Constraint&)` method. This way the same expansion feeds
+ * the PartialConstraintGraph and the CompactConstraintGraphBuilder.
+ *
+ * Only the rows ai in [first_ai, last_ai] are expanded, so that one dependency can be
+ * split between several workers. Cases are counted by the piece starting at ai=1.
+ *
+ * This version receives the Theorem 6 constants of the dependency ti -> tj for (Ki, Kj),
+ * the ones below get them from the model or from a ModelAnalysisContext.
+ */
+
+template <typename GRAPH>
+void new_algorithm2(TASK_ID ti_id, TASK_ID tj_id, const Theorem6Kernel& kernel, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj, GRAPH& graph, EXECUTION_COUNT first_ai, EXECUTION_COUNT last_ai) {
+
+
+	VERBOSE_NPCG("Algorithm 2 Starts ");
+
+	const INTEGER_TIME_UNIT Ti = kernel.Ti;
+	const INTEGER_TIME_UNIT Tj = kernel.Tj;
+
+	const EXECUTION_COUNT maxX = Ki;
+	const EXECUTION_COUNT maxY = Kj;
+
+	const INTEGER_TIME_UNIT gcdT = kernel.gcdT;
+	const INTEGER_TIME_UNIT gcdK = kernel.gcdK;
+	const INTEGER_TIME_UNIT Me = kernel.Me;
+
+	// By definition f00gcdz and g00gcdz are devisible by gcdz
+	const EXECUTION_COUNT f0gcdk = gcdT - Me;
+	const EXECUTION_COUNT g0gcdk = Ti - Me ;
+
+	const EXECUTION_COUNT Tx = Ti;
+	const EXECUTION_COUNT Ty = Tj;
+
+
+	VERBOSE_ASSERT(1 <= first_ai and last_ai <= maxX, "The ai range must be included in [1,Ki]");
+
+	VERBOSE_NPCG("Tx=" << Tx << " Ty=" << Ty << "");
+	VERBOSE_NPCG("Ki=" << Ki << " Kj=" << Kj << "");
+	VERBOSE_NPCG("gcdT=" << gcdT << " gcdK=" << gcdK << "");
+
+
+	VERBOSE_NPCG("Me=" << Me << "");
+
+
+	VERBOSE_NPCG("f0gcdk=" << f0gcdk << " g0gcdk=" << g0gcdk << "");
+
+
+	//const double f0 =  (double) f0gcdk / (double) gcdK;
+	//const double g0 =  (double) g0gcdk / (double) gcdK;
+
+	const EXECUTION_COUNT g = std::gcd(gcdK,Ty);
+
+	const EXECUTION_COUNT rjmripTimTj = kernel.rjmripTimTj;
+
+
+	// Algorithm 2
+	if (g0gcdk >= gcdK + f0gcdk) {
+		// Take them all
+		VERBOSE_NPCG (" Case 1 : Take them all");
+		LETITGO_INSTRUMENT(if (first_ai == 1) InstrumentationCounters::local().algorithm2.total_case1++;)
+
+
+		// Whole rows are computed by the vectorized kernel, then added.
+		std::vector<INTEGER_TIME_UNIT> row (Kj);
+		for (auto ai = first_ai; ai <= last_ai; ai++) {
+
+			const Execution ei(ti_id, ai);
+			theorem6_row(kernel, ai, Kj, row.data());
+
+			for (auto aj = 1; aj <= Kj; aj++) {
+
+				// From Theorem 6 (ECRTS2020)
+				const INTEGER_TIME_UNIT Lmax = row[aj - 1];
+
+				VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
+
+				const Execution ej(tj_id, aj);
+				const Constraint cij(ei, ej, Lmax);
+				graph.add(cij);
+
+			}
+		}
+		LETITGO_INSTRUMENT(InstrumentationCounters::local().case_edges[0] += (size_t) (last_ai - first_ai + 1) * (size_t) Kj;)
+	} else if (Ty == gcdK) {
+
+		VERBOSE_NPCG (" Case 2 : Ty == gcdK");
+		LETITGO_INSTRUMENT(if (first_ai == 1) InstrumentationCounters::local().algorithm2.total_case2++;)
+
+
+		VERBOSE_NPCG ("  g0=NA f0=NA Tx=" << Tx << " gcdK=" << gcdK);
+
+		// floor(gx0) == ceil(fx0) iff a multiple of gcdK lies in [f0gcdk - Tx * x, g0gcdk - Tx * x],
+		// that interval is shorter than gcdK out of case 1, so the test is pos_mod(Tx * x - f0gcdk, gcdK) <= g0gcdk - f0gcdk.
+		const INTEGER_TIME_UNIT width = g0gcdk - f0gcdk;
+		const INTEGER_TIME_UNIT Txmod = utils::pos_mod(Tx, gcdK);
+		INTEGER_TIME_UNIT residue = utils::pos_mod(Tx * first_ai - f0gcdk, gcdK);
+		std::vector<INTEGER_TIME_UNIT> row;
+
+		for (auto x = first_ai; x <= last_ai ; x++ ) {
+			VERBOSE_NPCG ("  Test x =" << x << " residue=" << residue);
+
+			if (residue <= width) {
+				VERBOSE_NPCG ("    Take (x,y) for every y");
+				// Take (x,y) for every y
+				const EXECUTION_COUNT ai = x;
+				LETITGO_INSTRUMENT(InstrumentationCounters::local().case_edges[1] += (size_t) Kj;)
+
+				const Execution ei(ti_id, ai);
+				row.resize(Kj);
+				theorem6_row(kernel, ai, Kj, row.data());
+				for (auto aj = 1; aj <= Kj; aj++) {
+
+					// From Theorem 6 (ECRTS2020)
+					const INTEGER_TIME_UNIT Lmax = row[aj - 1];
+
+					VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
+
+					const Execution ej(tj_id, aj);
+					const Constraint cij(ei, ej, Lmax);
+					graph.add(cij);
+
+
+				}
+			} else {
+
+				VERBOSE_NPCG ("    Skip it");
+			}
+
+			residue += Txmod;
+			if (residue >= gcdK) residue -= gcdK;
+		}
+	} else {
+
+		VERBOSE_NPCG (" Case 3 : algorithm 1");
+		LETITGO_INSTRUMENT(if (first_ai == 1) InstrumentationCounters::local().algorithm2.total_case3++;)
+
+		const long step = (gcdK)/g;
+
+		// Ty/g is invertible modulo step: the u0 of theta is (theta/g) * inverse modulo step.
+		const long inverse = utils::pos_mod(opt_extended_euclide ( Ty,  gcdK, g), step);
+		const long Tymod = utils::pos_mod(Ty, gcdK);
+		VERBOSE_ALGO1("g=" << g << " step=" << step << " inverse=" << inverse);
+		LETITGO_INSTRUMENT(size_t edges = 0, scanned = 0, kept = 0;)
+
+		for (EXECUTION_COUNT x = first_ai; x <= last_ai ; x++ ) {
+			VERBOSE_NPCG ("  Run algorithm 1 with x =" << x);
+			VERBOSE_ALGO1("Start algorithm 1 (x=" << x << ", f0=NA, g0=NA,  Tx=" << Tx << ", Ty=" << Ty << ", gcdK=" << gcdK << ", maxX=" << maxX << ",  maxY=" << maxY << ")");
+
+			VERBOSE_ALGO1(" Tx:" << Tx
+					<< " x:" << x
+					<< " g0:NA"
+					<< " f0:NA"
+					<< " g0gcdK:" << g0gcdk
+					<< " f0gcdK:" << f0gcdk
+					<< " gcdK:" << gcdK
+					<< " Ty:" << Ty);
+
+			const EXECUTION_COUNT ai = x;
+			const Execution ei(ti_id, ai);
+			const EXECUTION_COUNT alphae_ai_ajgcdeTaiside = (Ti * ai);
+
+			auto take = [&] (EXECUTION_COUNT aj) {
+				VERBOSE_ALGO1("  Take this ai,aj ( ai=" << x << ", aj=" << aj << " ) ");
+				const EXECUTION_COUNT alphae_ai_ajgcdeT = (alphae_ai_ajgcdeTaiside - Tj * aj);
+				const INTEGER_TIME_UNIT pi_min = kernel.pi_min(alphae_ai_ajgcdeT);
+
+				// From Theorem 6 (ECRTS2020)
+				const INTEGER_TIME_UNIT Lmax =
+						rjmripTimTj - (pi_min * gcdK + alphae_ai_ajgcdeT);
+
+				VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
+				const Execution ej(tj_id, aj);
+				const Constraint cij(ei, ej, Lmax);
+				graph.add(cij);
+				LETITGO_INSTRUMENT(edges++;)
+			};
+
+			const long start = (Tx * x - g0gcdk);
+			const long stop  = (Tx * x - f0gcdk);
+
+			// Only the multiples of g in [start, stop] have solutions.
+			const long first_theta = utils::ceil_div(start, g) * g;
+			const long theta_count = (first_theta > stop) ? 0 : (stop - first_theta) / g + 1;
+			VERBOSE_ALGO1("start=" << start << " stop=" << stop << " first_theta=" << first_theta << " theta_count=" << theta_count);
+
+			if (theta_count <= maxY) {
+				long y0 = (long) utils::pos_mod<utils::wide_integer>((utils::wide_integer) (first_theta / g) * inverse, step);
+				for (long theta = first_theta ; theta <= stop; theta += g ) {
+					VERBOSE_ALGO1(" Iteration theta=" << theta << " y0=" << y0);
+					LETITGO_INSTRUMENT(scanned++; if ((y0 ? y0 : step) <= maxY) kept++;)
+					for (long y = (y0 ? y0 : step) ; y <= maxY ; y += step ) {
+						take(y);
+					}
+					y0 += inverse;
+					if (y0 >= step) y0 -= step;
+				}
+			} else {
+				// More theta than y, y is taken iff Ty * y is congruent to some theta in [start, stop] modulo gcdK.
+				long residue = utils::pos_mod(Ty - start, gcdK);
+				for (long y = 1 ; y <= maxY ; y++ ) {
+					LETITGO_INSTRUMENT(scanned++;)
+					if (residue <= stop - start) {
+						LETITGO_INSTRUMENT(kept++;)
+						take(y);
+					}
+					residue += Tymod;
+					if (residue >= gcdK) residue -= gcdK;
+				}
+			}
+		}
+		LETITGO_INSTRUMENT(
+			InstrumentationCounters& counters = InstrumentationCounters::local();
+			counters.case_edges[2] += edges;
+			counters.theta_scanned += scanned;
+			counters.theta_kept += kept;
+		)
+	}
+}
+
+
+template <typename GRAPH>
+void new_algorithm2(const LETModel &model, const PeriodicityVector &K , const Dependency &d, GRAPH& graph, EXECUTION_COUNT first_ai, EXECUTION_COUNT last_ai) {
+	const TASK_ID ti_id = d.getFirst();
+	const TASK_ID tj_id = d.getSecond();
+	const Theorem6Kernel kernel (model.getTaskById(ti_id), model.getTaskById(tj_id), K[ti_id], K[tj_id]);
+	new_algorithm2(ti_id, tj_id, kernel, K[ti_id], K[tj_id], graph, first_ai, last_ai);
+}
+
+template <typename GRAPH>
+void new_algorithm2(const LETModel &model, const PeriodicityVector &K , const Dependency &d, GRAPH& graph) {
+	new_algorithm2(model, K, d, graph, 1, K[d.getFirst()]);
+}
+
+template <typename GRAPH>
+void new_algorithm2(const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, GRAPH& graph, EXECUTION_COUNT first_ai, EXECUTION_COUNT last_ai) {
+	LETITGO_DEPENDENCY_TIMER(did);
+	const DependencyConstants& d = context.getDependency(did);
+	new_algorithm2(d.ti, d.tj, context.getKernel(did, K), K[d.ti], K[d.tj], graph, first_ai, last_ai);
+}
+
+template <typename GRAPH>
+void new_algorithm2(const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, GRAPH& graph) {
+	new_algorithm2(context, K, did, graph, 1, K[context.getDependency(did).ti]);
+}
+
+
+#endif /* INCLUDE_ALGORITHM2_H_ */
@@ -10,7 +10,7 @@
 
 #include <model.h>
 #include <numeric>
-#include <chrono>
+#include <timing.h>
 #include <letitgo.h>
 #include <functional>
 
@@ -23,13 +23,56 @@ struct BenchmarkConfiguration  {
 	size_t seed;
 	bool detailed;
 	LETDatasetType kind;
+	size_t jobs = 1; // samples of a row run on that many workers, rows keep the serial order
+	bool pin_workers = false; // worker w runs on hardware thread w
+	utils::MeasureOptions measure; // warm-up and calibration of every timed function, iter_count is the minimum repetition count
+	bool percentiles = false; // print the timing statistics of every measured function after its row
+	std::string format = "text"; // text, json or csv, see benchmark_report.h
 };
 struct ExpansionBenchmarkConfiguration : public BenchmarkConfiguration {
+	size_t thread_count = 0; // parallel expansion, 0 means one per hardware thread
+};
+
+struct LongestPathBenchmarkConfiguration : public BenchmarkConfiguration {
+	std::vector<size_t> thread_counts = {1, 2, 4, 8, 16, 32};
+};
 
+/**
+ * Measures of benchmark_age_latency on top of the production timing, each one runs the samples again.
+ * Columns of the measures not taken are NaN (null in json).
+ */
+struct AgeLatencyMeasures {
+	bool checked = false;    // reference check and lower bounds (AgeLatencyOptions::checked)
+	bool gap = false;        // stop on the bound gap, with the iterations it saves
+	bool warm_start = false; // cold and warm start on a perturbed model, with the iterations it saves
 };
 
 struct AgeLantencyBenchmarkConfiguration : public BenchmarkConfiguration {
+	std::string engine = "expansion"; // expansion, fused, maxplus, reduced or incremental
+	std::string refinement = "path"; // path, neighbourhood, small_n, seeded or speculative
+	size_t speculative_threads = 1; // threads evaluating the candidates of a refinement, 0 for one per hardware thread
+	AgeLatencyMeasures measures;
+	bool measure_batch = false; // analyse every row again with ComputeAgeLatencyBatch
+	size_t batch_threads = 0; // threads of the ComputeAgeLatencyBatch column, 0 for one per hardware thread
+};
 
+struct BlockReplicationBenchmarkConfiguration : public BenchmarkConfiguration {
+	size_t k_divisor = 1; // K[t] = N[t] / gcd(N[t], k_divisor), 1 means K = N
+};
+
+/**
+ * What one sample adds to an ExpansionBenchmarkResult, samples are summed in seed order.
+ */
+struct ExpansionSample {
+	size_t seed = 0;
+	double time = 0;
+	long edge = 0;
+	long vertex = 0;
+	double memory = 0;
+	INTEGER_TIME_UNIT sum_n = 0;
+	Algorithm2_statistics algo2_stats;
+	PatternCache_statistics pattern_stats;
+	utils::TimingStatistics timing;
 };
 
 struct ExpansionBenchmarkResult {
@@ -39,7 +82,11 @@ struct ExpansionBenchmarkResult {
 	double average_time;
 	size_t total_vertex_count;
 	size_t total_edge_count;
-	ExpansionBenchmarkResult (size_t sample_count, double sum_n,  Algorithm2_statistics algo2_stats, double average_time, size_t total_vertex_count, size_t total_edge_count) : sample_count(sample_count), sum_n(sum_n), algo2_stats(algo2_stats), average_time(average_time) , total_vertex_count(total_vertex_count), total_edge_count(total_edge_count) {}
+	double average_memory; // Bytes held by the generated graph
+	PatternCache_statistics pattern_stats; // of a cache that lives for one expansion, whatever the expansion benchmarked
+	utils::TimingStatistics timing; // per call times of every sample
+	std::vector<ExpansionSample> samples; // in seed order
+	ExpansionBenchmarkResult (size_t sample_count, double sum_n,  Algorithm2_statistics algo2_stats, double average_time, size_t total_vertex_count, size_t total_edge_count, double average_memory = 0, PatternCache_statistics pattern_stats = PatternCache_statistics()) : sample_count(sample_count), sum_n(sum_n), algo2_stats(algo2_stats), average_time(average_time) , total_vertex_count(total_vertex_count), total_edge_count(total_edge_count), average_memory(average_memory), pattern_stats(pattern_stats) {}
 };
 
 /**
@@ -51,6 +98,16 @@ struct ExpansionBenchmarkResult {
 		bench_res.p_ctime += fun_res.path_computation_time;
 
  */
+/**
+ * One sample of an AgeLatencyBenchmarkResult: its seed, the analysis with lower bounds and statistics,
+ * and the per call times of the production analysis.
+ */
+struct AgeLatencySample {
+	size_t seed = 0;
+	AgeLatencyResult result;
+	utils::TimingStatistics timing;
+};
+
 struct AgeLatencyBenchmarkResult {
 
 		// Fixed
@@ -58,19 +115,38 @@ struct AgeLatencyBenchmarkResult {
 	  LETDatasetType dt = LETDatasetType::unknown_dt;
 
 	    // Could be average
-	  double time  = 0; // Execution Time of the algorithm
+	  double time  = 0; // Execution Time of the algorithm (production options)
+	  double checked_time = 0; // Execution Time with reference check and lower bounds
 	  double iter  = 0; // Number of required iteration
 	  double sum_n  = 0; // Max Possible Expansion size
 	  double size  = 0; // Expansion size as percent of V / N
 	  double bound = 0; // Error margin from the first bound t'ill the final result
 	  double g_ctime  = 0; // Graph generation time
 	  double p_ctime = 0; // Path computation time
+	  double gap_time = 0; // Execution Time when stopping on the bound gap
+	  double gap_saved_iter = 0; // Iterations not run thanks to the bound gap
+	  double cold_time = 0; // Execution Time on a perturbed model, from scratch
+	  double warm_time = 0; // Execution Time on the perturbed model, warm started from the original one
+	  double warm_saved_iter = 0; // Iterations not run thanks to the warm start
+	  double batch_time = 0; // Wall time per model when the samples are analysed by ComputeAgeLatencyBatch
+	  utils::TimingStatistics time_stats, checked_stats, gap_stats, cold_stats, warm_stats; // per call times behind the averages
+	  std::vector<AgeLatencySample> samples; // in seed order
 
 	  AgeLatencyBenchmarkResult (size_t n, size_t m, LETDatasetType dt) :
-		  n(n), m(m), dt(dt), time(0) , iter(0)  , sum_n(0),  size(0), bound(0) , g_ctime(0), p_ctime(0) {}
+		  n(n), m(m), dt(dt), time(0) , checked_time(0), iter(0)  , sum_n(0),  size(0), bound(0) , g_ctime(0), p_ctime(0), gap_time(0), gap_saved_iter(0), cold_time(0), warm_time(0), warm_saved_iter(0), batch_time(0) {}
 
 	  AgeLatencyBenchmarkResult (size_t n, size_t m, LETDatasetType dt, double t, double it, double sn, double s, double b, double g, double p) :
-		  n(n), m(m), dt(dt), time(t) , iter(it)  , sum_n(sn),  size(s), bound(b) , g_ctime(g), p_ctime(p) {}
+		  n(n), m(m), dt(dt), time(t) , checked_time(0), iter(it)  , sum_n(sn),  size(s), bound(b) , g_ctime(g), p_ctime(p), gap_time(0), gap_saved_iter(0), cold_time(0), warm_time(0), warm_saved_iter(0), batch_time(0) {}
+
+	  AgeLatencyBenchmarkResult& operator+= (const AgeLatencyBenchmarkResult& r) {
+		  time += r.time; checked_time += r.checked_time; iter += r.iter; sum_n += r.sum_n; size += r.size; bound += r.bound;
+		  g_ctime += r.g_ctime; p_ctime += r.p_ctime; gap_time += r.gap_time; gap_saved_iter += r.gap_saved_iter;
+		  cold_time += r.cold_time; warm_time += r.warm_time; warm_saved_iter += r.warm_saved_iter; batch_time += r.batch_time;
+		  time_stats = time_stats + r.time_stats; checked_stats = checked_stats + r.checked_stats; gap_stats = gap_stats + r.gap_stats;
+		  cold_stats = cold_stats + r.cold_stats; warm_stats = warm_stats + r.warm_stats;
+		  samples.insert(samples.end(), r.samples.begin(), r.samples.end());
+		  return *this;
+	  }
 };
 
 template <typename entier>
@@ -95,11 +171,15 @@ entier getSumN (LETModel& m) {
 }
 
 
-AgeLatencyBenchmarkResult benchmark_age_latency (AgeLatencyFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m, LETDatasetType dt, size_t seed);
-ExpansionBenchmarkResult  benchmark_expansion   (GenerateExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed);
+AgeLatencyBenchmarkResult benchmark_age_latency (AgeLatencyFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m, LETDatasetType dt, size_t seed, size_t jobs = 1, bool pin_workers = false, const utils::MeasureOptions& measure = utils::MeasureOptions(), const AgeLatencyMeasures& measures = AgeLatencyMeasures());
+ExpansionBenchmarkResult  benchmark_expansion   (GenerateExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed, size_t jobs = 1, bool pin_workers = false, const utils::MeasureOptions& measure = utils::MeasureOptions());
+ExpansionBenchmarkResult  benchmark_compact_expansion (GenerateCompactExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed, size_t jobs = 1, bool pin_workers = false, const utils::MeasureOptions& measure = utils::MeasureOptions());
 
 void main_benchmark_age_latency (AgeLantencyBenchmarkConfiguration config);
 void main_benchmark_expansion (ExpansionBenchmarkConfiguration config);
+void main_benchmark_longest_path (LongestPathBenchmarkConfiguration config);
+void main_benchmark_lmax_kernel (BenchmarkConfiguration config);
+void main_benchmark_block_replication (BlockReplicationBenchmarkConfiguration config);
 
 
 #endif /* INCLUDE_BENCHMARK_H_ */
@@ -0,0 +1,75 @@
+/*
+ * benchmark_report.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_BENCHMARK_REPORT_H_
+#define INCLUDE_BENCHMARK_REPORT_H_
+
+#include <benchmark.h>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Output of the benchmark binaries: the fixed width columns of the text format, or a machine-readable
+ * json document or csv table with every sample of every row.
+ */
+enum class BenchmarkFormat { text, json, csv };
+
+BenchmarkFormat str2format (const std::string& str);
+
+/**
+ * Where a benchmark ran, reported with its results.
+ */
+struct BenchmarkEnvironment {
+	std::string git_revision;
+	std::string host;
+	std::string system;
+	std::string compiler;
+	size_t hardware_threads = 0;
+
+	static BenchmarkEnvironment current ();
+};
+
+/**
+ * Name and json literal of the configuration entries of a benchmark, json_string and json_number build the literals.
+ */
+typedef std::vector<std::pair<std::string, std::string>> BenchmarkReportFields;
+
+std::string json_string (const std::string& str);
+std::string json_number (double value);
+BenchmarkReportFields configuration_fields (const BenchmarkConfiguration& config);
+
+/**
+ * Writes the rows of one benchmark as they are produced, json rows hold their samples and csv has one line per
+ * sample (expansion) or per iteration of a sample (age latency). The configuration and the environment are
+ * the json header, or # comment lines before the csv header. The json document is closed by close or the destructor.
+ */
+class BenchmarkReport {
+	std::ostream& stream;
+	BenchmarkFormat format;
+	size_t row_count = 0;
+	bool begun = false;
+	bool closed = false;
+
+	void begin (const std::string& benchmark, const BenchmarkReportFields& configuration, const std::string& csv_header);
+	void begin_json_row ();
+
+public:
+	BenchmarkReport (std::ostream& stream, BenchmarkFormat format) : stream(stream), format(format) {}
+	~BenchmarkReport () { close(); }
+
+	void begin_age_latency (const BenchmarkReportFields& configuration);
+	void begin_expansion (const BenchmarkReportFields& configuration);
+
+	void add_age_latency_row (const AgeLatencyBenchmarkResult& bench);
+	void add_expansion_row (const std::string& function, LETDatasetType dt, bool harmonized_periodicity, size_t n, size_t m, const ExpansionBenchmarkResult& bench);
+
+	void close ();
+};
+
+#endif /* INCLUDE_BENCHMARK_REPORT_H_ */
@@ -0,0 +1,60 @@
+/*
+ * block_replication.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_BLOCK_REPLICATION_H_
+#define INCLUDE_BLOCK_REPLICATION_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <integer_arithmetic.h>
+#include <compact_constraint_graph.h>
+#include <algorithm>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_BRE(m) VERBOSE_CUSTOM_DEBUG("BRE", m)
+#else
+#define VERBOSE_BRE(m) {}
+#endif
+
+/**
+ * Whether (ai, aj) is a constraint and its Lmax only depend on Ti * ai - Tj * aj modulo gcdK,
+ * so the constraints of a dependency are invariant by any shift (da, db) with Ti * da = Tj * db mod gcdK:
+ *
+ *  - rows and columns are the smallest shifts along ai and along aj, they divide Ki and Kj;
+ *  - (lattice_rows, lattice_columns) = (Tj, Ti) / gcdT keeps Ti * ai - Tj * aj unchanged,
+ *    row ai + lattice_rows is row ai rotated by lattice_columns along aj.
+ *
+ * The weights are the same in every copy. Algorithm 2 only has to expand base_rows x columns pairs,
+ * gcdK / gcdT when the lattice step is the shortest, instead of Ki x Kj.
+ */
+struct ConstraintBlock {
+	EXECUTION_COUNT rows;
+	EXECUTION_COUNT columns;
+	EXECUTION_COUNT lattice_rows;
+	EXECUTION_COUNT lattice_columns;
+	EXECUTION_COUNT base_rows;
+
+	explicit ConstraintBlock (const Theorem6Kernel& kernel)
+	: rows (kernel.gcdK / std::gcd(kernel.gcdK, kernel.Ti)),
+	  columns (kernel.gcdK / std::gcd(kernel.gcdK, kernel.Tj)),
+	  lattice_rows (kernel.Tj / kernel.gcdT),
+	  lattice_columns (kernel.Ti / kernel.gcdT),
+	  base_rows (std::min(rows, lattice_rows)) {}
+
+	inline EXECUTION_COUNT size () const { return base_rows * columns; }
+};
+
+/**
+ * Same graph as generate_compact_constraint_graph. Algorithm 2 only expands the base rows
+ * of each dependency over one column period. Every other row is then a copy of these edges
+ * in the builder arrays, with shifted execution ids.
+ */
+CompactConstraintGraph block_generate_compact_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K);
+CompactConstraintGraph block_generate_compact_constraint_graph (const LETModel &model, const PeriodicityVector &K);
+
+
+#endif /* INCLUDE_BLOCK_REPLICATION_H_ */
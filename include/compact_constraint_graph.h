@@ -0,0 +1,351 @@
+/*
+ * compact_constraint_graph.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_COMPACT_CONSTRAINT_GRAPH_H_
+#define INCLUDE_COMPACT_CONSTRAINT_GRAPH_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <partial_constraint_graph.h>
+#include <model_analysis_context.h>
+#include <verbose.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+/**
+ * Dense identifier of an execution inside a CompactConstraintGraph.
+ *
+ * Id 0 is the start execution s = Execution(-1,0), id 1 the finish execution f = Execution(-1,1),
+ * then the K[t] executions of every task t are numbered consecutively from task_offsets[t].
+ * Ids order executions exactly like operator< on Execution does.
+ */
+typedef uint32_t EXECUTION_ID;
+
+/**
+ * CompactConstraintGraph stores the same constraints as PartialConstraintGraph,
+ * but as CSR arrays (offsets, destinations, weights) in both directions.
+ *
+ * A constraint costs 2 * (sizeof(EXECUTION_ID) + sizeof(WEIGHT)) bytes instead of
+ * three red-black tree nodes. The graph is immutable, it is produced by CompactConstraintGraphBuilder.
+ */
+class CompactConstraintGraph {
+
+public:
+	static constexpr EXECUTION_ID START  = 0;
+	static constexpr EXECUTION_ID FINISH = 1;
+
+private:
+	std::vector<size_t>       task_offsets;     // first id of the executions of each task, size n+1
+
+	std::vector<size_t>       out_offsets;      // size V+1
+	std::vector<EXECUTION_ID> out_destinations; // size E
+	std::vector<WEIGHT>       out_weights;      // size E
+
+	std::vector<size_t>       in_offsets;       // size V+1
+	std::vector<EXECUTION_ID> in_sources;       // size E
+	std::vector<WEIGHT>       in_weights;       // size E
+
+	size_t execution_count = 0;                 // executions with at least one constraint
+
+	friend class CompactConstraintGraphBuilder;
+
+public:
+
+	/**
+	 * Iterates over a contiguous range of CSR edges and returns them as Constraint values.
+	 * The anchor is the execution that owns the current edge (source for outbounds, destination for inbounds).
+	 */
+	class ConstraintIterator {
+		const CompactConstraintGraph* graph;
+		bool inbound;
+		EXECUTION_ID anchor;
+		size_t edge;
+
+		inline void skip_empty () {
+			const std::vector<size_t>& offsets = inbound ? graph->in_offsets : graph->out_offsets;
+			while (anchor + 1 < offsets.size() and edge >= offsets[anchor + 1]) anchor++;
+		}
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Constraint value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const Constraint* pointer;
+		typedef Constraint reference;
+
+		ConstraintIterator(const CompactConstraintGraph* graph, bool inbound, EXECUTION_ID anchor, size_t edge)
+		: graph(graph), inbound(inbound), anchor(anchor), edge(edge) { skip_empty(); }
+
+		inline Constraint operator*() const {
+			if (inbound) {
+				return Constraint(graph->getExecution(graph->in_sources[edge]), graph->getExecution(anchor), graph->in_weights[edge]);
+			}
+			return Constraint(graph->getExecution(anchor), graph->getExecution(graph->out_destinations[edge]), graph->out_weights[edge]);
+		}
+		inline ConstraintIterator& operator++() { edge++; skip_empty(); return *this; }
+		inline ConstraintIterator operator++(int) { ConstraintIterator tmp = *this; ++(*this); return tmp; }
+		inline friend bool operator==(const ConstraintIterator& l, const ConstraintIterator& r) { return l.edge == r.edge; }
+		inline friend bool operator!=(const ConstraintIterator& l, const ConstraintIterator& r) { return l.edge != r.edge; }
+	};
+
+	class ConstraintRange {
+		ConstraintIterator first, last;
+		size_t count;
+	public:
+		ConstraintRange(ConstraintIterator first, ConstraintIterator last, size_t count) : first(first), last(last), count(count) {}
+		inline ConstraintIterator begin() const { return first; }
+		inline ConstraintIterator end() const { return last; }
+		inline size_t size() const { return count; }
+		inline bool empty() const { return count == 0; }
+	};
+
+	/**
+	 * Iterates over the executions that own at least one constraint, in increasing order.
+	 */
+	class ExecutionIterator {
+		const CompactConstraintGraph* graph;
+		EXECUTION_ID id;
+
+		inline void skip_isolated () {
+			while (id < graph->getVertexCount() and graph->getInputCount(id) + graph->getOutputCount(id) == 0) id++;
+		}
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Execution value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const Execution* pointer;
+		typedef Execution reference;
+
+		ExecutionIterator(const CompactConstraintGraph* graph, EXECUTION_ID id) : graph(graph), id(id) { skip_isolated(); }
+		inline Execution operator*() const { return graph->getExecution(id); }
+		inline ExecutionIterator& operator++() { id++; skip_isolated(); return *this; }
+		inline ExecutionIterator operator++(int) { ExecutionIterator tmp = *this; ++(*this); return tmp; }
+		inline friend bool operator==(const ExecutionIterator& l, const ExecutionIterator& r) { return l.id == r.id; }
+		inline friend bool operator!=(const ExecutionIterator& l, const ExecutionIterator& r) { return l.id != r.id; }
+	};
+
+	class ExecutionRange {
+		ExecutionIterator first, last;
+		size_t count;
+	public:
+		ExecutionRange(ExecutionIterator first, ExecutionIterator last, size_t count) : first(first), last(last), count(count) {}
+		inline ExecutionIterator begin() const { return first; }
+		inline ExecutionIterator end() const { return last; }
+		inline size_t size() const { return count; }
+		inline bool empty() const { return count == 0; }
+	};
+
+public:
+
+	// Id mapping
+
+	inline size_t getVertexCount() const { return out_offsets.empty() ? 0 : out_offsets.size() - 1; }
+
+	inline EXECUTION_ID getExecutionId(const Execution& e) const {
+		if (e.getTaskId() == -1) return (EXECUTION_ID) e.second;
+		return (EXECUTION_ID) (task_offsets[e.getTaskId()] + e.second - 1);
+	}
+
+	inline Execution getExecution(EXECUTION_ID id) const {
+		if (id < 2) return Execution(-1, id);
+		const TASK_ID tid = std::upper_bound(task_offsets.begin(), task_offsets.end(), (size_t) id) - task_offsets.begin() - 1;
+		return Execution(tid, id - task_offsets[tid] + 1);
+	}
+
+	inline bool contains(const Execution& e) const {
+		if (e.getTaskId() == -1) return e.second == 0 or e.second == 1;
+		if (e.getTaskId() < 0 or (size_t) e.getTaskId() + 1 >= task_offsets.size()) return false;
+		return e.second >= 1 and task_offsets[e.getTaskId()] + e.second - 1 < task_offsets[e.getTaskId() + 1];
+	}
+
+	// Ids of the executions of task t are [taskBegin(t), taskEnd(t))
+
+	inline size_t getTaskCount() const { return task_offsets.empty() ? 0 : task_offsets.size() - 1; }
+	inline EXECUTION_ID taskBegin(TASK_ID t) const { return (EXECUTION_ID) task_offsets[t]; }
+	inline EXECUTION_ID taskEnd(TASK_ID t) const { return (EXECUTION_ID) task_offsets[t + 1]; }
+
+	// Raw CSR access, meant for the path algorithms
+
+	inline size_t getOutputCount(EXECUTION_ID id) const { return out_offsets[id + 1] - out_offsets[id]; }
+	inline size_t getInputCount(EXECUTION_ID id) const { return in_offsets[id + 1] - in_offsets[id]; }
+
+	inline size_t outBegin(EXECUTION_ID id) const { return out_offsets[id]; }
+	inline size_t outEnd(EXECUTION_ID id) const { return out_offsets[id + 1]; }
+	inline size_t inBegin(EXECUTION_ID id) const { return in_offsets[id]; }
+	inline size_t inEnd(EXECUTION_ID id) const { return in_offsets[id + 1]; }
+
+	inline EXECUTION_ID getOutDestination(size_t edge) const { return out_destinations[edge]; }
+	inline WEIGHT getOutWeight(size_t edge) const { return out_weights[edge]; }
+	inline EXECUTION_ID getInSource(size_t edge) const { return in_sources[edge]; }
+	inline WEIGHT getInWeight(size_t edge) const { return in_weights[edge]; }
+
+	// PartialConstraintGraph-like views
+
+	inline ConstraintRange getInputs(Execution e) const {
+		if (not contains(e)) return ConstraintRange(end_constraint(), end_constraint(), 0);
+		const EXECUTION_ID id = getExecutionId(e);
+		return ConstraintRange(ConstraintIterator(this, true, id, in_offsets[id]),
+				               ConstraintIterator(this, true, id, in_offsets[id + 1]),
+							   getInputCount(id));
+	}
+
+	inline ConstraintRange getOutputs(Execution e) const {
+		if (not contains(e)) return ConstraintRange(end_constraint(), end_constraint(), 0);
+		const EXECUTION_ID id = getExecutionId(e);
+		return ConstraintRange(ConstraintIterator(this, false, id, out_offsets[id]),
+				               ConstraintIterator(this, false, id, out_offsets[id + 1]),
+							   getOutputCount(id));
+	}
+
+	inline ConstraintRange getConstraints() const {
+		return ConstraintRange(ConstraintIterator(this, false, 0, 0), end_constraint(), getConstraintCount());
+	}
+
+	inline ExecutionRange getExecutions() const {
+		return ExecutionRange(ExecutionIterator(this, 0), ExecutionIterator(this, getVertexCount()), execution_count);
+	}
+
+	inline size_t getConstraintCount() const { return out_destinations.size(); }
+	inline size_t getExecutionCount() const { return execution_count; }
+
+	/**
+	 * Bytes held by the CSR arrays.
+	 */
+	size_t memory_footprint() const;
+
+	friend std::ostream &operator<<(std::ostream &stream, const CompactConstraintGraph &obj) {
+		stream << "CompactConstraintGraph(" << std::endl;
+		for (auto c : obj.getConstraints()) {
+			stream << "  " << c ;
+			stream << std::endl;
+		}
+		stream << ")" << std::endl;
+		return stream;
+	}
+
+	friend bool operator==(const CompactConstraintGraph & a1, const CompactConstraintGraph & a2) {
+		return a1.getExecutionCount() == a2.getExecutionCount()
+			and a1.getConstraintCount() == a2.getConstraintCount()
+			and std::equal(a1.getExecutions().begin(), a1.getExecutions().end(), a2.getExecutions().begin())
+			and std::equal(a1.getConstraints().begin(), a1.getConstraints().end(), a2.getConstraints().begin());
+	}
+	friend bool operator!=(const CompactConstraintGraph & a1, const CompactConstraintGraph & a2) {
+		return not (a1 == a2);
+	}
+
+	friend bool operator==(const CompactConstraintGraph & a1, const PartialConstraintGraph & a2) {
+		return a1.getExecutionCount() == a2.getExecutions().size()
+			and a1.getConstraintCount() == a2.getConstraints().size()
+			and std::equal(a1.getExecutions().begin(), a1.getExecutions().end(), a2.getExecutions().begin())
+			and std::equal(a1.getConstraints().begin(), a1.getConstraints().end(), a2.getConstraints().begin());
+	}
+	friend bool operator==(const PartialConstraintGraph & a1, const CompactConstraintGraph & a2) { return a2 == a1; }
+	friend bool operator!=(const CompactConstraintGraph & a1, const PartialConstraintGraph & a2) { return not (a1 == a2); }
+	friend bool operator!=(const PartialConstraintGraph & a1, const CompactConstraintGraph & a2) { return not (a2 == a1); }
+
+private:
+	inline ConstraintIterator end_constraint() const {
+		return ConstraintIterator(this, false, getVertexCount(), getConstraintCount());
+	}
+};
+
+
+/**
+ * Collects constraints in a flat edge list (one pass over the generators),
+ * then sorts them into the two CSR directions in build().
+ *
+ * As with PartialConstraintGraph, identical constraints are merged.
+ */
+class CompactConstraintGraphBuilder {
+
+	CompactConstraintGraph graph;
+
+	std::vector<EXECUTION_ID> sources;
+	std::vector<EXECUTION_ID> destinations;
+	std::vector<WEIGHT>       weights;
+
+public:
+	CompactConstraintGraphBuilder (const LETModel &model, const PeriodicityVector &K);
+
+	inline EXECUTION_ID getExecutionId(const Execution& e) const { return graph.getExecutionId(e); }
+	inline size_t getVertexCount() const { return graph.task_offsets.back(); }
+
+	inline void add(EXECUTION_ID src, EXECUTION_ID dst, WEIGHT w) {
+		sources.push_back(src);
+		destinations.push_back(dst);
+		weights.push_back(w);
+	}
+
+	inline void add(const Constraint& c) {
+		this->add(getExecutionId(c.getSource()), getExecutionId(c.getDestination()), c.getWeight());
+	}
+
+	inline void reserve (size_t edge_count) {
+		sources.reserve(edge_count);
+		destinations.reserve(edge_count);
+		weights.reserve(edge_count);
+	}
+
+	inline size_t getEdgeCount() const { return sources.size(); }
+
+	/**
+	 * Appends a copy of the edges [first_edge, first_edge + count), sources shifted by source_shift
+	 * and destinations by destination_shift. Weights are copied as they are.
+	 */
+	inline void replicate (size_t first_edge, size_t count, long source_shift, long destination_shift) {
+		VERBOSE_ASSERT(first_edge + count <= sources.size(), "Replicated edges must already be in the builder");
+		const size_t last = sources.size();
+		sources.resize(last + count);
+		destinations.resize(last + count);
+		weights.resize(last + count);
+		// Indexes rather than iterators, the resizes may have moved the arrays.
+		std::transform(sources.begin() + first_edge, sources.begin() + first_edge + count, sources.begin() + last,
+				[source_shift] (EXECUTION_ID id) { return (EXECUTION_ID) (id + source_shift); });
+		std::transform(destinations.begin() + first_edge, destinations.begin() + first_edge + count, destinations.begin() + last,
+				[destination_shift] (EXECUTION_ID id) { return (EXECUTION_ID) (id + destination_shift); });
+		std::copy(weights.begin() + first_edge, weights.begin() + first_edge + count, weights.begin() + last);
+	}
+
+	inline const std::vector<EXECUTION_ID>& getSources() const { return sources; }
+	inline const std::vector<EXECUTION_ID>& getDestinations() const { return destinations; }
+
+	/**
+	 * Produce the CSR graph, the builder is left empty.
+	 */
+	CompactConstraintGraph build();
+};
+
+
+typedef ExpansionFun<CompactConstraintGraph> GenerateCompactExpansionFun;
+
+void add_start_finish (const LETModel &model, const PeriodicityVector &K, CompactConstraintGraphBuilder& builder);
+
+CompactConstraintGraph generate_compact_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K);
+CompactConstraintGraph generate_compact_constraint_graph (const LETModel &model, const PeriodicityVector &K);
+CompactConstraintGraph parallel_generate_compact_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K, size_t thread_count);
+CompactConstraintGraph parallel_generate_compact_constraint_graph (const LETModel &model, const PeriodicityVector &K, size_t thread_count);
+GenerateCompactExpansionFun parallel_compact_expansion (size_t thread_count);
+
+std::vector<Execution> topologicalOrder (const CompactConstraintGraph& PKG) ;
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  FindLongestPath(const CompactConstraintGraph& PKG);
+
+/**
+ * Longest path level by level, the executions of a level are relaxed on thread_count threads
+ * (0 means one per hardware thread), started once for all the levels. Each execution pulls from its inbound constraints so no lock is needed.
+ * Distances are the ones of FindLongestPath. When several predecessors give the same distance the one
+ * with the smallest id is kept, so the result does not depend on thread_count, but among several critical
+ * paths it can return another one than FindLongestPath.
+ */
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  ParallelFindLongestPath(const CompactConstraintGraph& PKG, const TaskLevels& levels, size_t thread_count);
+
+
+#endif /* INCLUDE_COMPACT_CONSTRAINT_GRAPH_H_ */
@@ -0,0 +1,133 @@
+/*
+ * constraint_pattern_cache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_CONSTRAINT_PATTERN_CACHE_H_
+#define INCLUDE_CONSTRAINT_PATTERN_CACHE_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <partial_constraint_graph.h>
+#include <model_analysis_context.h>
+#include <algorithm2.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_CPC(m) VERBOSE_CUSTOM_DEBUG("CPC", m)
+#else
+#define VERBOSE_CPC(m) {}
+#endif
+
+/**
+ * Which (ai, aj) Algorithm 2 takes only depends on Ti, Tj, Me, Ki and Kj, and
+ * Lmax - (rj - ri + Ti - Tj) only depends on them too. Me itself is a function of
+ * (Ti, Tj, ri - rj + Di), so dependencies sharing (Ti, Tj, ri - rj, Di, Ki, Kj) always share a pattern.
+ */
+struct ConstraintPatternKey {
+	INTEGER_TIME_UNIT Ti, Tj, Me;
+	EXECUTION_COUNT Ki, Kj;
+
+	friend bool operator== (const ConstraintPatternKey& a, const ConstraintPatternKey& b) {
+		return a.Ti == b.Ti and a.Tj == b.Tj and a.Me == b.Me and a.Ki == b.Ki and a.Kj == b.Kj;
+	}
+};
+
+struct ConstraintPatternKeyHash {
+	inline size_t operator() (const ConstraintPatternKey& k) const {
+		size_t h = std::hash<INTEGER_TIME_UNIT>()(k.Ti);
+		for (long v : {k.Tj, k.Me, k.Ki, k.Kj}) h = h * 1000003 ^ std::hash<long>()(v);
+		return h;
+	}
+};
+
+/**
+ * Constraints of one dependency with their weight relative to rj - ri + Ti - Tj.
+ */
+struct ConstraintPattern {
+	struct Entry {
+		EXECUTION_COUNT ai;
+		EXECUTION_COUNT aj;
+		WEIGHT relative_weight;
+	};
+	std::vector<Entry> entries;
+	InstrumentationCounters stats; // what Algorithm 2 counted for the pattern, replayed on each hit
+
+	inline size_t memory_footprint () const { return sizeof(ConstraintPattern) + entries.capacity() * sizeof(Entry); }
+};
+
+/**
+ * Memo table of Algorithm 2 patterns, keys do not depend on task ids so a cache
+ * can be shared between models and between the iterations of ComputeAgeLatency.
+ * Once max_bytes are held new patterns are still generated but not stored (0 means no limit).
+ * Not thread-safe.
+ */
+class ConstraintPatternCache {
+
+	std::unordered_map<ConstraintPatternKey, ConstraintPattern, ConstraintPatternKeyHash> patterns;
+	size_t max_bytes;
+	PatternCache_statistics stats;
+
+	/**
+	 * new_algorithm2 sink that records the constraints of a pattern.
+	 */
+	struct Recorder {
+		ConstraintPattern& pattern;
+		WEIGHT base;
+		inline void add(const Constraint& c) {
+			pattern.entries.push_back({c.getSource().second, c.getDestination().second, c.getWeight() - base});
+		}
+	};
+
+	const ConstraintPattern& lookup (const ConstraintPatternKey& key, TASK_ID ti_id, TASK_ID tj_id, const Theorem6Kernel& kernel, ConstraintPattern& scratch);
+
+public:
+
+	explicit ConstraintPatternCache (size_t max_bytes = 64 * 1024 * 1024) : max_bytes(max_bytes) {}
+
+	/**
+	 * Same constraints as new_algorithm2(context, K, did, graph), stamped from the pattern of the dependency.
+	 */
+	template <typename GRAPH>
+	void expand (const ModelAnalysisContext &context, const PeriodicityVector &K, DEPENDENCY_ID did, GRAPH& graph) {
+		LETITGO_DEPENDENCY_TIMER(did);
+		const DependencyConstants& d = context.getDependency(did);
+		const Theorem6Kernel kernel = context.getKernel(did, K);
+		const ConstraintPatternKey key = {kernel.Ti, kernel.Tj, kernel.Me, K[d.ti], K[d.tj]};
+
+		ConstraintPattern scratch;
+		const ConstraintPattern& pattern = lookup(key, d.ti, d.tj, kernel, scratch);
+
+		LETITGO_INSTRUMENT(InstrumentationCounters::local() += pattern.stats;)
+		for (const ConstraintPattern::Entry& e : pattern.entries) {
+			graph.add(Constraint(Execution(d.ti, e.ai), Execution(d.tj, e.aj), kernel.rjmripTimTj + e.relative_weight));
+		}
+	}
+
+	inline const PatternCache_statistics& getStatistics () const { return stats; }
+	void clear ();
+};
+
+/**
+ * Same graph as opt_new_generate_partial_constraint_graph, with a cache that lives for one call.
+ * Its statistics are added to InstrumentationCounters::local().pattern_cache.
+ */
+PartialConstraintGraph cached_generate_partial_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K);
+PartialConstraintGraph cached_generate_partial_constraint_graph (const LETModel &model, const PeriodicityVector &K);
+
+/**
+ * Same, with a cache owned by the caller. pattern_cache_expansion shares one cache between
+ * every call of the returned function, so ComputeAgeLatency iterations reuse the patterns of
+ * dependencies whose Ki and Kj did not change. Calls of the returned function are serialized.
+ * What a call added to the cache statistics is added to InstrumentationCounters::local().pattern_cache.
+ */
+PartialConstraintGraph generate_partial_constraint_graph_with_cache (const ModelAnalysisContext &context, const PeriodicityVector &K, ConstraintPatternCache& cache);
+PartialConstraintGraph generate_partial_constraint_graph_with_cache (const LETModel &model, const PeriodicityVector &K, ConstraintPatternCache& cache);
+GenerateExpansionFun pattern_cache_expansion (std::shared_ptr<ConstraintPatternCache> cache);
+
+
+#endif /* INCLUDE_CONSTRAINT_PATTERN_CACHE_H_ */
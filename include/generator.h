@@ -11,6 +11,8 @@
 #include <model.h>
 #include <periodicity_vector.h>
 #include <functional>
+#include <map>
+#include <mutex>
 
 typedef std::function<PeriodicityVector(LETModel &m, size_t seed)> PeriodicityVectorGenerationFunction;
 typedef std::function<LETModel(unsigned int n, unsigned int m, size_t seed)> LETGenerationFunction;
@@ -36,6 +38,11 @@ LETModel generate_Generic_LET (unsigned int n, unsigned int m, size_t seed = 0);
 PeriodicityVector generate_random_periodicity_vector(const LETModel &model, size_t seed = 0);
 PeriodicityVector generate_random_ni_periodicity_vector(const LETModel &model, size_t seed = 0);
 
+/**
+ * Copy of model where the offset of task tid is moved by delta, the perturbation of a design-space exploration step.
+ */
+LETModel shift_task_offset (const LETModel &model, TASK_ID tid, TIME_UNIT delta);
+
 
 struct GeneratorCacheEntry {
 	LETDatasetType t;
@@ -64,9 +71,18 @@ struct GeneratorCacheEntry {
 
 class Generator {
 
+	// Benchmark workers generate their samples concurrently.
 	std::map <GeneratorCacheEntry, LETModel> cache;
+	mutable std::mutex cache_mutex;
 
 public:
+	Generator () {}
+	// Copies keep the cached models, not the lock.
+	Generator (const Generator& other) {
+		std::lock_guard<std::mutex> lock (other.cache_mutex);
+		cache = other.cache;
+	}
+
 	LETModel generateAutomotive (size_t n, size_t m, size_t seed) {
 		return this->generate(LETDatasetType::automotive_dt, n , m , seed);
 	}
@@ -79,20 +95,24 @@ public:
 	LETModel generate (LETDatasetType t, size_t n, size_t m, size_t seed) {
 		VERBOSE_ASSERT(seed > 0 , "The generator need positive seed");
 		GeneratorCacheEntry entry(t, n, m, seed);
+		{
+			std::lock_guard<std::mutex> lock (cache_mutex);
+			auto it = cache.find(entry);
+			if (it != cache.end()) return it->second;
+		}
 
-		if (cache.count(entry) == 0) {
-			LETGenerationFunction fun = generate_Automotive_LET;
-			switch (t) {
-				case LETDatasetType::generic_dt : fun = generate_Generic_LET; break;
-				case LETDatasetType::harmonic_dt : fun = generate_Harmonic_LET; break;
-				case LETDatasetType::automotive_dt : fun = generate_Automotive_LET; break;
-				default : fun = generate_Automotive_LET;
-			}
-			LETModel model = fun (n, m, seed);
-			cache[entry] = model;
+		// Generation only depends on the entry, it runs unlocked and the first one stored wins.
+		LETGenerationFunction fun = generate_Automotive_LET;
+		switch (t) {
+			case LETDatasetType::generic_dt : fun = generate_Generic_LET; break;
+			case LETDatasetType::harmonic_dt : fun = generate_Harmonic_LET; break;
+			case LETDatasetType::automotive_dt : fun = generate_Automotive_LET; break;
+			default : fun = generate_Automotive_LET;
 		}
+		LETModel model = fun (n, m, seed);
 
-		return cache[entry];
+		std::lock_guard<std::mutex> lock (cache_mutex);
+		return cache.emplace(entry, model).first->second;
 	}
 
 	static Generator& getInstance () {
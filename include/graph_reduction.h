@@ -0,0 +1,58 @@
+/*
+ * graph_reduction.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_GRAPH_REDUCTION_H_
+#define INCLUDE_GRAPH_REDUCTION_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <compact_constraint_graph.h>
+#include <unordered_map>
+#include <vector>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_REDUCTION(m) VERBOSE_CUSTOM_DEBUG("REDUCTION", m)
+#else
+#define VERBOSE_REDUCTION(m) {}
+#endif
+
+struct GraphReductionOptions {
+	bool dominated = true; // remove u -> v when some u -> x -> v is at least as long
+	bool series    = true; // contract executions with exactly one input and one output
+	size_t max_intermediate_pairs = 64; // x is only tried as an intermediate when inputs(x) * outputs(x) is below
+};
+
+/**
+ * A CompactConstraintGraph with the same longest distances from s as the expansion it comes from,
+ * on the same execution ids. Contracted constraints remember the executions they went through,
+ * so a path of the reduced graph can be expanded back to a path of the original one.
+ */
+struct ReducedConstraintGraph {
+	CompactConstraintGraph graph;
+	std::unordered_map<uint64_t, std::vector<EXECUTION_ID>> chains; // (source << 32 | destination) to the contracted executions
+
+	size_t parallel_count   = 0; // constraints removed because a parallel one is longer
+	size_t dominated_count  = 0; // constraints removed because a two-hop route is as long
+	size_t contracted_count = 0; // executions contracted into a constraint
+
+	static inline uint64_t key (EXECUTION_ID source, EXECUTION_ID destination) { return ((uint64_t) source << 32) | destination; }
+
+	/**
+	 * Path of the original graph, from a path of the reduced one.
+	 */
+	std::vector<Execution> expand (const std::vector<Execution>& path) const;
+};
+
+ReducedConstraintGraph reduce_constraint_graph (const LETModel &model, const PeriodicityVector &K, const CompactConstraintGraph& graph, const GraphReductionOptions& options = GraphReductionOptions());
+
+/**
+ * Longest path of the reduced graph, returned as a path of the original graph.
+ */
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  FindLongestPath(const ReducedConstraintGraph& PKG);
+
+
+#endif /* INCLUDE_GRAPH_REDUCTION_H_ */
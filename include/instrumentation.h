@@ -0,0 +1,161 @@
+/*
+ * instrumentation.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_INSTRUMENTATION_H_
+#define INCLUDE_INSTRUMENTATION_H_
+
+#include <model.h>
+#include <timing.h>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * The counters (Algorithm 2 cases, edges per case, case 3 theta values, time per dependency and phase timers)
+ * are compiled in with LETITGO_INSTRUMENTATION=1 and cost nothing otherwise. The letitgo_instrumented library,
+ * linked by the tests and the <benchmark>_instrumented targets, always has them, letitgo only with the cmake
+ * option of the same name.
+ */
+#ifndef LETITGO_INSTRUMENTATION
+#define LETITGO_INSTRUMENTATION 0
+#endif
+
+#if LETITGO_INSTRUMENTATION
+#define LETITGO_INSTRUMENT(...) __VA_ARGS__
+#define LETITGO_PHASE_TIMER(name) const InstrumentationPhaseTimer instrumentation_phase_timer (name)
+#define LETITGO_DEPENDENCY_TIMER(did) const InstrumentationDependencyTimer instrumentation_dependency_timer (did)
+#else
+#define LETITGO_INSTRUMENT(...)
+#define LETITGO_PHASE_TIMER(name) {}
+#define LETITGO_DEPENDENCY_TIMER(did) {}
+#endif
+
+struct Algorithm2_statistics {
+
+	size_t total_case1 = 0;
+	size_t total_case2 = 0;
+	size_t total_case3 = 0;
+
+	void clear () {
+		this->total_case1 = 0;
+		this->total_case2 = 0;
+		this->total_case3 = 0;
+	}
+
+	friend Algorithm2_statistics operator+(const Algorithm2_statistics&l, const Algorithm2_statistics& r) {
+		Algorithm2_statistics res;
+		res.clear();
+		res.total_case1 = l.total_case1 + r.total_case1;
+		res.total_case2 = l.total_case2 + r.total_case2;
+		res.total_case3 = l.total_case3 + r.total_case3;
+		return res;
+	}
+};
+
+struct PatternCache_statistics {
+
+	size_t lookups = 0;
+	size_t hits = 0;
+	size_t patterns = 0; // stored patterns
+	size_t bytes = 0;    // held by the stored patterns
+
+	inline double hit_rate () const { return lookups ? (double) hits / (double) lookups : 0.0; }
+
+	void clear () { *this = PatternCache_statistics(); }
+
+	PatternCache_statistics& operator+= (const PatternCache_statistics& r) {
+		lookups  += r.lookups;
+		hits     += r.hits;
+		patterns += r.patterns;
+		bytes    += r.bytes;
+		return *this;
+	}
+	friend PatternCache_statistics operator+(PatternCache_statistics l, const PatternCache_statistics& r) { return l += r; }
+
+	// What a cache counted between two snapshots, its counters only grow until clear().
+	friend PatternCache_statistics operator-(const PatternCache_statistics&l, const PatternCache_statistics& r) {
+		PatternCache_statistics res;
+		res.lookups  = l.lookups  - r.lookups;
+		res.hits     = l.hits     - r.hits;
+		res.patterns = l.patterns - r.patterns;
+		res.bytes    = l.bytes    - r.bytes;
+		return res;
+	}
+
+	friend std::ostream &operator<<(std::ostream &stream, const PatternCache_statistics &obj) {
+		stream << "<PatternCache_statistics lookups=" << obj.lookups << " hits=" << obj.hits
+				<< " patterns=" << obj.patterns << " bytes=" << obj.bytes << ">";
+		return stream;
+	}
+};
+
+/**
+ * What the expansion did, counted per thread without synchronization. Work done on other threads
+ * is merged back by whoever waits for it, an analysis call returns the counters of its own work.
+ */
+struct InstrumentationCounters {
+	Algorithm2_statistics algorithm2;
+	size_t case_edges[3] = {0, 0, 0}; // constraints emitted by Algorithm 2, per case
+	size_t theta_scanned = 0; // case 3 candidates visited, theta values or y when there are more theta than y
+	size_t theta_kept = 0; // case 3 candidates that gave at least one constraint
+	std::vector<double> dependency_time; // ms per DEPENDENCY_ID, in the expansion
+	std::map<std::string, double> phase_time; // ms per scoped phase
+	PatternCache_statistics pattern_cache; // lookups of the pattern caches, per generator call
+
+	static InstrumentationCounters& local ();
+	void clear () { *this = InstrumentationCounters(); }
+
+	void add_dependency_time (DEPENDENCY_ID did, double ms);
+	InstrumentationCounters& operator+= (const InstrumentationCounters& r);
+	friend InstrumentationCounters operator+ (InstrumentationCounters l, const InstrumentationCounters& r) { return l += r; }
+
+	friend std::ostream &operator<<(std::ostream &stream, const InstrumentationCounters &obj) {
+		stream << "<InstrumentationCounters"
+				<< " case1=" << obj.algorithm2.total_case1 << "/" << obj.case_edges[0]
+				<< " case2=" << obj.algorithm2.total_case2 << "/" << obj.case_edges[1]
+				<< " case3=" << obj.algorithm2.total_case3 << "/" << obj.case_edges[2]
+				<< " theta=" << obj.theta_kept << "/" << obj.theta_scanned
+				<< " patterns=" << obj.pattern_cache.hits << "/" << obj.pattern_cache.lookups;
+		for (const auto& phase : obj.phase_time) stream << " " << phase.first << "=" << phase.second;
+		stream << ">";
+		return stream;
+	}
+};
+
+/**
+ * Counters of the work done on the calling thread while the scope lives. The counters of the thread
+ * are put aside on construction and restored with what the scope counted on destruction.
+ */
+class InstrumentationScope {
+	InstrumentationCounters saved;
+public:
+	InstrumentationScope () : saved(InstrumentationCounters::local()) { InstrumentationCounters::local().clear(); }
+	~InstrumentationScope () { InstrumentationCounters::local() = saved + InstrumentationCounters::local(); }
+	InstrumentationScope (const InstrumentationScope&) = delete;
+	InstrumentationScope& operator= (const InstrumentationScope&) = delete;
+
+	inline const InstrumentationCounters& collect () const { return InstrumentationCounters::local(); }
+};
+
+class InstrumentationPhaseTimer {
+	const char* name;
+	const utils::TimePoint start;
+public:
+	explicit InstrumentationPhaseTimer (const char* name) : name(name), start(utils::now()) {}
+	~InstrumentationPhaseTimer () { InstrumentationCounters::local().phase_time[name] += utils::elapsed_ms(start); }
+};
+
+class InstrumentationDependencyTimer {
+	const DEPENDENCY_ID did;
+	const utils::TimePoint start;
+public:
+	explicit InstrumentationDependencyTimer (DEPENDENCY_ID did) : did(did), start(utils::now()) {}
+	~InstrumentationDependencyTimer () { InstrumentationCounters::local().add_dependency_time(did, utils::elapsed_ms(start)); }
+};
+
+#endif /* INCLUDE_INSTRUMENTATION_H_ */
@@ -0,0 +1,154 @@
+/*
+ * integer_arithmetic.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_INTEGER_ARITHMETIC_H_
+#define INCLUDE_INTEGER_ARITHMETIC_H_
+
+#include <model.h>
+#include <verbose.h>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <ostream>
+
+/**
+ * Exact integer arithmetic used by the expansions (Theorem 6, ECRTS2020).
+ *
+ * The C++ division truncates toward zero, floor_div and ceil_div round toward
+ * minus and plus infinity, so that pi_min/pi_max do not need to go through double.
+ */
+
+namespace utils {
+
+typedef __int128 wide_integer;
+
+template <typename entier>
+inline entier floor_div (entier a, entier b) {
+	const entier q = a / b;
+	return ((a % b != 0) and ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+template <typename entier>
+inline entier ceil_div (entier a, entier b) {
+	const entier q = a / b;
+	return ((a % b != 0) and ((a < 0) == (b < 0))) ? q + 1 : q;
+}
+
+/**
+ * a mod b in [0, |b|).
+ */
+template <typename entier>
+inline entier pos_mod (entier a, entier b) {
+	const entier r = a % b;
+	return (r < 0) ? r + (b < 0 ? -b : b) : r;
+}
+
+/**
+ * a * b computed on 128 bits, asserts the result fits in a long.
+ */
+inline long checked_mul (long a, long b) {
+	const wide_integer res = (wide_integer) a * (wide_integer) b;
+	VERBOSE_ASSERT(res >= std::numeric_limits<long>::min() and res <= std::numeric_limits<long>::max(),
+			"Integer overflow in " << a << " * " << b);
+	return (long) res;
+}
+
+/**
+ * floor(a * b / c) and ceil(a * b / c) with a 128 bits intermediate product.
+ */
+inline long mul_floor_div (long a, long b, long c) {
+	return (long) floor_div<wide_integer>((wide_integer) a * (wide_integer) b, c);
+}
+
+inline long mul_ceil_div (long a, long b, long c) {
+	return (long) ceil_div<wide_integer>((wide_integer) a * (wide_integer) b, c);
+}
+
+/**
+ * Release dates and deadlines are stored as TIME_UNIT, the expansions need them as integers.
+ * Precondition: v is an integer, LETModel::addTask rejects a model that would break it.
+ */
+inline INTEGER_TIME_UNIT exact_integer (TIME_UNIT v) {
+	const INTEGER_TIME_UNIT res = (INTEGER_TIME_UNIT) v;
+	VERBOSE_ASSERT((TIME_UNIT) res == v, "Time value " << v << " is not an integer");
+	return res;
+}
+
+}
+
+/**
+ * Constants of a dependency ti -> tj shared by every (ai, aj) of Theorem 6 (ECRTS2020).
+ *
+ *   Me     = Tj + ceil((ri - rj + Di) / gcdT) * gcdT
+ *   alpha  = (Ti * ai - Tj * aj) / gcdT
+ *   pi_min = ceil  ((-Me + gcdT - alpha * gcdT) / gcdK)
+ *   pi_max = floor ((-Me + Ti   - alpha * gcdT) / gcdK)
+ *   Lmax   = rj - ri + Ti - Tj - (pi_min * gcdK + alpha * gcdT)
+ *
+ * The constructor checks Ti*Ki and Tj*Kj fit in a long, every product of the
+ * inner loops is bounded by them, so the loops run on plain long.
+ */
+struct Theorem6Kernel {
+	INTEGER_TIME_UNIT Ti, Tj;
+	INTEGER_TIME_UNIT gcdT;
+	INTEGER_TIME_UNIT gcdK;
+	INTEGER_TIME_UNIT Me;
+	INTEGER_TIME_UNIT rjmripTimTj; // rj - ri + Ti - Tj
+
+	Theorem6Kernel (const Task& ti, const Task& tj, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT gcdK)
+	: Ti(ti.getT()), Tj(tj.getT()), gcdT(std::gcd(Ti, Tj)), gcdK(gcdK),
+	  Me (Tj + utils::ceil_div(utils::exact_integer(ti.getr()) - utils::exact_integer(tj.getr()) + utils::exact_integer(ti.getD()), gcdT) * gcdT),
+	  rjmripTimTj(utils::exact_integer(tj.getr()) - utils::exact_integer(ti.getr()) + Ti - Tj) {
+		utils::checked_mul(Ti, Ki);
+		utils::checked_mul(Tj, Kj);
+	}
+
+	Theorem6Kernel (const Task& ti, const Task& tj, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj)
+	: Theorem6Kernel (ti, tj, Ki, Kj, std::gcd(utils::checked_mul(ti.getT(), Ki), utils::checked_mul(tj.getT(), Kj))) {}
+
+	// Same dependency for another (Ki, Kj), only gcdK depends on them.
+	Theorem6Kernel (const Theorem6Kernel& base, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj)
+	: Ti(base.Ti), Tj(base.Tj), gcdT(base.gcdT), gcdK(std::gcd(utils::checked_mul(Ti, Ki), utils::checked_mul(Tj, Kj))),
+	  Me(base.Me), rjmripTimTj(base.rjmripTimTj) {}
+
+	// alpha * gcdT = Ti * ai - Tj * aj
+	inline INTEGER_TIME_UNIT alphagcdT (EXECUTION_COUNT ai, EXECUTION_COUNT aj) const { return Ti * ai - Tj * aj; }
+
+	inline INTEGER_TIME_UNIT pi_min (INTEGER_TIME_UNIT alphagcdT) const { return utils::ceil_div (-Me + gcdT - alphagcdT, gcdK); }
+	inline INTEGER_TIME_UNIT pi_max (INTEGER_TIME_UNIT alphagcdT) const { return utils::floor_div(-Me + Ti   - alphagcdT, gcdK); }
+
+	inline INTEGER_TIME_UNIT Lmax (INTEGER_TIME_UNIT alphagcdT) const { return rjmripTimTj - (pi_min(alphagcdT) * gcdK + alphagcdT); }
+};
+
+
+/**
+ * Row kernel of Algorithm 2 case 1 (every (ai, aj) is a constraint).
+ *
+ * With pi_min * gcdK = num + pos_mod(-num, gcdK), Lmax of a row simplifies to
+ *
+ *   Lmax(aj) = rj - ri + Ti - Tj + Me - gcdT - pos_mod(Me - gcdT + Ti * ai - Tj * aj, gcdK)
+ *
+ * The modulo decreases by Tj mod gcdK from one aj to the next, so a row needs no division,
+ * and W consecutive aj are computed together in the lanes of a vector register.
+ */
+enum class RowKernelIsa { scalar, avx2, avx512 };
+
+std::ostream& operator<< (std::ostream& stream, const RowKernelIsa& isa);
+
+/**
+ * Best instruction set supported by the running CPU.
+ */
+RowKernelIsa detect_row_kernel_isa ();
+
+/**
+ * Fills Lmax[aj - 1] for aj in [1, Kj], bit-exact with Theorem6Kernel::Lmax whatever the isa.
+ */
+void theorem6_row (const Theorem6Kernel& kernel, EXECUTION_COUNT ai, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax, RowKernelIsa isa);
+void theorem6_row (const Theorem6Kernel& kernel, EXECUTION_COUNT ai, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax);
+
+
+#endif /* INCLUDE_INTEGER_ARITHMETIC_H_ */
@@ -10,8 +10,18 @@
 
 
 #include <utils.h>
+#include <integer_arithmetic.h>
+#include <model_analysis_context.h>
+#include <parallel.h>
+#include <timing.h>
 #include <periodicity_vector.h>
 #include <partial_constraint_graph.h>
+#include <compact_constraint_graph.h>
+#include <constraint_pattern_cache.h>
+#include <block_replication.h>
+#include <max_plus.h>
+#include <graph_reduction.h>
+#include <refinement_strategy.h>
 #include <age_latency.h>
 #include <generator.h>
 
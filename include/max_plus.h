@@ -0,0 +1,62 @@
+/*
+ * max_plus.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_MAX_PLUS_H_
+#define INCLUDE_MAX_PLUS_H_
+
+#include <model.h>
+#include <integer_arithmetic.h>
+#include <limits>
+#include <vector>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_MAXPLUS(m) VERBOSE_CUSTOM_DEBUG("MAXPLUS", m)
+#else
+#define VERBOSE_MAXPLUS(m) {}
+#endif
+
+/**
+ * The max-plus -infinity. Far enough from the type limits that adding a distance
+ * cannot wrap around, anything below MAX_PLUS_UNREACHED was never reached by a constraint.
+ */
+static constexpr WEIGHT MAX_PLUS_NONE      = std::numeric_limits<WEIGHT>::min() / 4;
+static constexpr WEIGHT MAX_PLUS_UNREACHED = MAX_PLUS_NONE / 2;
+
+/**
+ * The constraints of a dependency ti -> tj as a Ki x Kj max-plus matrix,
+ * weights(ai, aj) is Lmax when Algorithm 2 takes (ai, aj) and MAX_PLUS_NONE otherwise.
+ *
+ * Only the rows with at least one constraint are stored, each one with the band
+ * [first, last) of columns outside of which it only holds MAX_PLUS_NONE.
+ */
+struct MaxPlusBlock {
+	EXECUTION_COUNT Ki = 0;
+	EXECUTION_COUNT Kj = 0;
+	std::vector<EXECUTION_COUNT> rows;  // ai of the stored rows, increasing
+	std::vector<EXECUTION_COUNT> first; // first column (aj - 1) of the band of each stored row
+	std::vector<EXECUTION_COUNT> last;  // one past its last column
+	std::vector<WEIGHT> weights;        // rows.size() x Kj
+	size_t constraint_count = 0;
+
+	inline const WEIGHT* row (size_t r) const { return weights.data() + r * Kj; }
+};
+
+/**
+ * Rows come from theorem6_row, (ai, aj) is taken iff Lmax >= rj - ri + Ti - Tj + Me - Ti,
+ * which is the pi_min <= pi_max test of Algorithm 2.
+ */
+MaxPlusBlock make_max_plus_block (const Theorem6Kernel& kernel, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj);
+
+/**
+ * For k in [0, count): when distance + weights[k] > dist[k], dist[k] takes it and prev[k] becomes predecessor.
+ * Bit-exact whatever the isa.
+ */
+void max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count, RowKernelIsa isa);
+void max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count);
+
+
+#endif /* INCLUDE_MAX_PLUS_H_ */
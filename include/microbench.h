@@ -0,0 +1,54 @@
+/*
+ * microbench.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_MICROBENCH_H_
+#define INCLUDE_MICROBENCH_H_
+
+#include <timing.h>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Time of one hot kernel on a fixed input. edges and executions are what one call processes,
+ * 0 when the kernel does not work on a graph.
+ */
+struct MicrobenchResult {
+	std::string name;
+	size_t edges = 0;
+	size_t executions = 0;
+	utils::TimingStatistics timing;
+
+	inline double ns_per_edge () const { return edges ? timing.median * 1e6 / (double) edges : 0; }
+	inline double ns_per_execution () const { return executions ? timing.median * 1e6 / (double) executions : 0; }
+};
+
+struct MicrobenchConfiguration {
+	std::string filter; // only the kernels whose name contains it, empty for all
+	utils::MeasureOptions measure;
+	std::string baseline; // output of a previous run, empty for no comparison
+	double threshold = 0.1; // a median more than (1 + threshold) times the baseline one is a slowdown
+	MicrobenchConfiguration () { measure.warmup = 2; measure.target_time = 200; measure.min_repetitions = 5; }
+};
+
+/**
+ * Kernels are named kernel/input, for example new_algorithm2/case3/generic.
+ */
+std::vector<MicrobenchResult> run_microbenchmarks (const std::string& filter, const utils::MeasureOptions& measure);
+
+/**
+ * Median milliseconds per kernel name, from the output of main_microbench.
+ */
+std::map<std::string, double> read_microbench_baseline (std::istream& input);
+
+/**
+ * Prints one row per kernel, compared with the baseline when there is one, and returns the slowdown count.
+ */
+size_t main_microbench (const MicrobenchConfiguration& config);
+
+#endif /* INCLUDE_MICROBENCH_H_ */
@@ -10,9 +10,12 @@
 
 #include <verbose.h>
 
+#include <cmath>
 #include <map>
 #include <ostream>
 #include <set>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 typedef double TIME_UNIT;
@@ -118,7 +121,16 @@ public:
 	TASK_ID addTask(TIME_UNIT r, INTEGER_TIME_UNIT DandT) {
 		return this->addTask(r, DandT, DandT);
 	}
+	/**
+	 * Release dates are TIME_UNIT but the expansions compute on integers (integer_arithmetic.h),
+	 * a release date that is not an integer is rejected here rather than inside an analysis.
+	 */
 	TASK_ID addTask(TIME_UNIT r, INTEGER_TIME_UNIT D, INTEGER_TIME_UNIT T) {
+		if (std::floor(r) != r) {
+			std::ostringstream message;
+			message << "Task release date r=" << r << " is not an integer, LET models need integer release dates, deadlines and periods";
+			throw std::runtime_error(message.str());
+		}
 		const TASK_ID id = TaskIdToTask.size();
 		const Task t(id, r, D, D, T);
 		TaskIdToTask.push_back(t);
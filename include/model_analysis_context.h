@@ -0,0 +1,147 @@
+/*
+ * model_analysis_context.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_MODEL_ANALYSIS_CONTEXT_H_
+#define INCLUDE_MODEL_ANALYSIS_CONTEXT_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <integer_arithmetic.h>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Tasks grouped by topological level: a task is one level after the highest of its predecessors.
+ * Constraints only link executions of dependent tasks, so they always go to a higher level.
+ */
+typedef std::vector<std::vector<TASK_ID>> TaskLevels;
+TaskLevels computeTaskLevels (const LETModel& model);
+
+/**
+ * Kahn's algorithm on the task graph, a cycle between tasks is an error.
+ */
+std::vector<TASK_ID> computeTaskTopologicalOrder (const LETModel& model);
+
+/**
+ * Constants of dependency ti -> tj that do not depend on K.
+ * The kernel is built with Ki = Kj = 1, ModelAnalysisContext::getKernel completes it for a K.
+ */
+struct DependencyConstants {
+	TASK_ID ti;
+	TASK_ID tj;
+	Theorem6Kernel kernel;
+	DependencyConstants (const Task& ti, const Task& tj) : ti(ti.getId()), tj(tj.getId()), kernel(ti, tj, 1, 1) {}
+};
+
+/**
+ * Everything derived from a LETModel alone, built once and shared by the expansions,
+ * the longest path and ComputeAgeLatency. The model must outlive the context.
+ */
+class ModelAnalysisContext {
+
+	const LETModel& model;
+
+	std::vector<INTEGER_TIME_UNIT> periods;
+	std::vector<INTEGER_TIME_UNIT> offsets;
+	std::vector<INTEGER_TIME_UNIT> deadlines;
+
+	INTEGER_TIME_UNIT hyperperiod; // 0 when it does not fit in a long, N is then empty
+	std::vector<INTEGER_TIME_UNIT> N; // repetition vector, hyperperiod / T
+	size_t sum_n;
+
+	std::vector<DependencyConstants> dependencies;
+	std::vector<std::vector<DEPENDENCY_ID>> inputs;  // dependencies ending at a task
+	std::vector<std::vector<DEPENDENCY_ID>> outputs; // dependencies starting at a task
+
+	// Only the engines that walk the task DAG need these, they are built on first use.
+	// The other analyses still accept a cyclic task graph.
+	mutable std::once_flag order_once;
+	mutable std::vector<TASK_ID> order;
+	mutable std::once_flag levels_once;
+	mutable TaskLevels levels;
+
+	TIME_UNIT setup_time; // milliseconds
+
+public:
+
+	explicit ModelAnalysisContext (const LETModel& model);
+
+	// A context refers to its model, copies would silently share it.
+	ModelAnalysisContext (const ModelAnalysisContext&) = delete;
+	ModelAnalysisContext& operator= (const ModelAnalysisContext&) = delete;
+
+	inline const LETModel& getModel () const { return model; }
+
+	inline size_t getTaskCount () const { return periods.size(); }
+	inline size_t getDependencyCount () const { return dependencies.size(); }
+
+	inline INTEGER_TIME_UNIT getPeriod (TASK_ID tid) const { return periods[tid]; }
+	inline INTEGER_TIME_UNIT getOffset (TASK_ID tid) const { return offsets[tid]; }
+	inline INTEGER_TIME_UNIT getDeadline (TASK_ID tid) const { return deadlines[tid]; }
+
+	inline INTEGER_TIME_UNIT getHyperperiod () const { return hyperperiod; }
+	inline INTEGER_TIME_UNIT getN (TASK_ID tid) const { return N[tid]; }
+	inline const std::vector<INTEGER_TIME_UNIT>& getRepetitionVector () const { return N; }
+	inline size_t getSumN () const { return sum_n; }
+
+	inline const DependencyConstants& getDependency (DEPENDENCY_ID did) const { return dependencies[did]; }
+	inline const std::vector<DEPENDENCY_ID>& getInputs (TASK_ID tid) const { return inputs[tid]; }
+	inline const std::vector<DEPENDENCY_ID>& getOutputs (TASK_ID tid) const { return outputs[tid]; }
+
+	/**
+	 * Theorem 6 constants of dependency did for the periodicity vector K, only gcdK is computed.
+	 */
+	inline Theorem6Kernel getKernel (DEPENDENCY_ID did, const PeriodicityVector& K) const {
+		const DependencyConstants& d = dependencies[did];
+		return Theorem6Kernel(d.kernel, K[d.ti], K[d.tj]);
+	}
+
+	/**
+	 * Built on the first call, thread safe. The task graph must be acyclic.
+	 */
+	const std::vector<TASK_ID>& getTopologicalOrder () const;
+	const TaskLevels& getTaskLevels () const;
+
+	inline TIME_UNIT getSetupTime () const { return setup_time; }
+};
+
+/**
+ * Expansion of a model into a GRAPH for K, called with the context ComputeAgeLatency built once for the model.
+ * A function pointer selects the context overload of a generator. Generators that take the model are still
+ * accepted, and the expansion can still be called on a model: in both cases a context is built per call.
+ */
+template <typename GRAPH>
+class ExpansionFun : public std::function<GRAPH(const ModelAnalysisContext &context, const PeriodicityVector& K)> {
+
+	typedef std::function<GRAPH(const ModelAnalysisContext &context, const PeriodicityVector& K)> ContextFun;
+
+	template <typename F>
+	using takes_context = std::is_invocable_r<GRAPH, F&, const ModelAnalysisContext&, const PeriodicityVector&>;
+	template <typename F>
+	using takes_model = std::is_invocable_r<GRAPH, F&, const LETModel&, const PeriodicityVector&>;
+
+public:
+	ExpansionFun () {}
+	ExpansionFun (GRAPH (*fun) (const ModelAnalysisContext &context, const PeriodicityVector& K)) : ContextFun (fun) {}
+
+	template <typename F, typename std::enable_if<takes_context<F>::value, int>::type = 0>
+	ExpansionFun (F fun) : ContextFun (std::move(fun)) {}
+
+	template <typename F, typename std::enable_if<not takes_context<F>::value and takes_model<F>::value, long>::type = 0>
+	ExpansionFun (F fun) : ContextFun ([fun] (const ModelAnalysisContext &context, const PeriodicityVector& K) { return fun(context.getModel(), K); }) {}
+
+	using ContextFun::operator();
+	GRAPH operator() (const LETModel &model, const PeriodicityVector& K) const {
+		const ModelAnalysisContext context (model);
+		return ContextFun::operator()(context, K);
+	}
+};
+
+
+#endif /* INCLUDE_MODEL_ANALYSIS_CONTEXT_H_ */
@@ -0,0 +1,67 @@
+/*
+ * parallel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_PARALLEL_H_
+#define INCLUDE_PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Number of hardware threads, at least 1.
+ */
+size_t hardware_thread_count ();
+
+/**
+ * Resolve a thread count setting, 0 means one per hardware thread.
+ */
+inline size_t resolve_thread_count (size_t thread_count) {
+	return thread_count ? thread_count : hardware_thread_count();
+}
+
+/**
+ * Run body(i) for every i in [0, count) on thread_count threads (0 means hardware_thread_count()).
+ * Indices are handed out dynamically, in increasing order, the calling thread takes part.
+ * The first exception thrown by a body is rethrown once every thread is done.
+ */
+void parallel_for (size_t count, size_t thread_count, const std::function<void(size_t)>& body);
+
+/**
+ * Run body(phase, i) for every i in [0, counts[phase]), phase after phase, on thread_count threads
+ * (0 means hardware_thread_count()). The threads are started once for every phase, a barrier
+ * separates two phases. Indices of a phase are handed out dynamically, the calling thread takes part.
+ * The first exception thrown by a body is rethrown once every thread is done, later phases are skipped.
+ */
+void parallel_for_phases (const std::vector<size_t>& counts, size_t thread_count, const std::function<void(size_t, size_t)>& body);
+
+/**
+ * Run body(item, worker) for every item in [0, costs.size()) on a work-stealing pool of thread_count
+ * threads (0 means hardware_thread_count()), worker is in [0, thread_count), 0 being the calling thread.
+ * Items are dealt round robin in decreasing cost, each worker takes the front of its own queue and,
+ * once it is empty, steals the back of the longest other one. Costs only drive the scheduling.
+ * With pin_workers, worker w runs on hardware thread w (modulo their count) and the calling thread is released at the end.
+ * The first exception thrown by a body is rethrown once every thread is done.
+ * Returns the number of stolen items.
+ */
+size_t work_stealing_for (const std::vector<double>& costs, size_t thread_count, const std::function<void(size_t, size_t)>& body, bool pin_workers = false);
+
+/**
+ * Restrict the calling thread to hardware thread cpu (modulo their count), false where it is not supported.
+ */
+bool pin_current_thread (size_t cpu);
+
+/**
+ * Allow the calling thread on every hardware thread again.
+ */
+void unpin_current_thread ();
+
+} // namespace utils
+
+#endif /* INCLUDE_PARALLEL_H_ */
@@ -10,7 +10,10 @@
 
 #include <model.h>
 #include <periodicity_vector.h>
+#include <model_analysis_context.h>
+#include <instrumentation.h>
 #include <verbose.h>
+#include <utils.h>
 #include <functional>
 
 #ifdef ULTRA_DEBUG
@@ -20,16 +23,37 @@
 #endif
 
 
+typedef std::set<Execution, std::less<Execution>, utils::CountingAllocator<Execution>> ExecutionSet;
+typedef std::set<Constraint, std::less<Constraint>, utils::CountingAllocator<Constraint>> ConstraintSet;
+typedef std::map<Execution, ConstraintSet, std::less<Execution>, utils::CountingAllocator<std::pair<const Execution, ConstraintSet>>> ConstraintSetMap;
+
 class PartialConstraintGraph {
-  std::set<Execution> executions;
-  std::set<Constraint> constraints;
+  ExecutionSet executions;
+  ConstraintSet constraints;
 
 public:
-  std::map<Execution, std::set<Constraint>> inbounds;
-  std::map<Execution, std::set<Constraint>> outbounds;
+  ConstraintSetMap inbounds;
+  ConstraintSetMap outbounds;
+
+  typedef utils::IteratorRange<ConstraintSet::const_iterator> ConstraintRange;
+
+private:
+  inline static ConstraintRange view(const ConstraintSetMap& bounds, const Execution& e) {
+    auto it = bounds.find(e);
+    if (it == bounds.end()) {
+      static const ConstraintSet empty;
+      return ConstraintRange(empty.begin(), empty.end(), 0);
+    }
+    return ConstraintRange(it->second.begin(), it->second.end(), it->second.size());
+  }
+
+  inline static size_t degree(const ConstraintSetMap& bounds, const Execution& e) {
+    auto it = bounds.find(e);
+    return (it == bounds.end()) ? 0 : it->second.size();
+  }
 
 public:
-  inline void add(Constraint c) {
+  inline void add(const Constraint& c) {
 
 	executions.insert(c.getSource());
     executions.insert(c.getDestination());
@@ -38,20 +62,51 @@ public:
     outbounds[c.getSource()].insert(c);
   };
 
-  inline const std::set<Constraint> getInputs(Execution e) const {
-    if (inbounds.count(e))
-      return inbounds.at(e);
-    return std::set<Constraint>();
-  }
+  /**
+   * Remove c (if present), executions left without constraint are removed too,
+   * so that the graph is equal to the one built without c.
+   */
+  inline void remove(const Constraint& c) {
+    if (constraints.erase(c) == 0) return;
 
-  inline const std::set<Constraint> getOutputs(Execution e) const {
-    if (outbounds.count(e))
-      return outbounds.at(e);
-    return std::set<Constraint>();
-  }
+    const Execution src = c.getSource();
+    const Execution dst = c.getDestination();
+
+    auto in = inbounds.find(dst);
+    in->second.erase(c);
+    if (in->second.empty()) inbounds.erase(in);
+
+    auto out = outbounds.find(src);
+    out->second.erase(c);
+    if (out->second.empty()) outbounds.erase(out);
+
+    for (const Execution& e : {src, dst}) {
+      if (getInputCount(e) + getOutputCount(e) == 0) executions.erase(e);
+    }
+  };
 
-  inline const std::set<Constraint> getConstraints() const { return constraints; }
-  inline const std::set<Execution> getExecutions() const { return executions; }
+  // Zero-copy read API, views stay valid as long as the graph is not modified.
+
+  inline ConstraintRange getInputs(const Execution& e) const { return view(inbounds, e); }
+  inline ConstraintRange getOutputs(const Execution& e) const { return view(outbounds, e); }
+
+  inline size_t getInputCount(const Execution& e) const { return degree(inbounds, e); }
+  inline size_t getOutputCount(const Execution& e) const { return degree(outbounds, e); }
+
+  inline const ConstraintSet& getConstraints() const { return constraints; }
+  inline const ExecutionSet& getExecutions() const { return executions; }
+
+  /**
+   * Estimated bytes held by the red-black trees (node payload plus parent/left/right/color header,
+   * allocator overhead is not counted).
+   */
+  inline size_t memory_footprint() const {
+    const size_t node = 4 * sizeof(void*);
+    size_t res = executions.size() * (node + sizeof(Execution)) + constraints.size() * (node + sizeof(Constraint));
+    for (auto& in : inbounds) res += node + sizeof(in) + in.second.size() * (node + sizeof(Constraint));
+    for (auto& out : outbounds) res += node + sizeof(out) + out.second.size() * (node + sizeof(Constraint));
+    return res;
+  }
 
 
   friend std::ostream &operator<<(std::ostream &stream,
@@ -86,47 +141,37 @@ public:
 
 
 
-struct Algorithm2_statistics {
-
-	size_t total_case1 = 0;
-	size_t total_case2 = 0;
-	size_t total_case3 = 0;
-
-	static Algorithm2_statistics & getSingleton() {
-		static Algorithm2_statistics current;
-		return current;
-	}
-	void clear () {
-		this->total_case1 = 0;
-		this->total_case2 = 0;
-		this->total_case3 = 0;
-	}
-
-	friend Algorithm2_statistics operator+(const Algorithm2_statistics&l, const Algorithm2_statistics& r) {
-		Algorithm2_statistics res;
-		res.clear();
-		res.total_case1 = l.total_case1 + r.total_case1;
-		res.total_case2 = l.total_case2 + r.total_case2;
-		res.total_case3 = l.total_case3 + r.total_case3;
-		return res;
-	}
-};
-
-
-typedef std::function<PartialConstraintGraph(const LETModel &model, const PeriodicityVector& K)> GenerateExpansionFun;
+typedef ExpansionFun<PartialConstraintGraph> GenerateExpansionFun;
 
+void add_constraints (const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, PartialConstraintGraph& graph);
 void add_constraints (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph);
 void add_start_finish (const LETModel &model, const PeriodicityVector &K, PartialConstraintGraph& graph);
 
+/**
+ * Generators take the context of the model, the LETModel overloads build one per call.
+ */
+PartialConstraintGraph generate_partial_constraint_graph (const ModelAnalysisContext& context , const PeriodicityVector& K) ;
 PartialConstraintGraph generate_partial_constraint_graph (const LETModel& model , const PeriodicityVector& K) ;
+PartialConstraintGraph new_generate_partial_constraint_graph(const ModelAnalysisContext &context, const PeriodicityVector &K) ;
 PartialConstraintGraph new_generate_partial_constraint_graph(const LETModel &model, const PeriodicityVector &K) ;
+PartialConstraintGraph opt_new_generate_partial_constraint_graph(const ModelAnalysisContext &context, const PeriodicityVector &K) ;
 PartialConstraintGraph opt_new_generate_partial_constraint_graph(const LETModel &model, const PeriodicityVector &K) ;
 
+/**
+ * Same graph as opt_new_generate_partial_constraint_graph, dependencies (or ai ranges of the large ones)
+ * are expanded on thread_count threads, 0 means one per hardware thread.
+ */
+PartialConstraintGraph parallel_generate_partial_constraint_graph(const ModelAnalysisContext &context, const PeriodicityVector &K, size_t thread_count) ;
+PartialConstraintGraph parallel_generate_partial_constraint_graph(const LETModel &model, const PeriodicityVector &K, size_t thread_count) ;
+GenerateExpansionFun parallel_expansion (size_t thread_count) ;
+
 
-std::vector<Execution> topologicalOrder (PartialConstraintGraph PKG) ;
-std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  FindLongestPath(PartialConstraintGraph PKG);
+std::vector<Execution> topologicalOrder (const PartialConstraintGraph& PKG) ;
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  FindLongestPath(const PartialConstraintGraph& PKG);
 
+void add_lowerbounds (const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, PartialConstraintGraph& graph);
 void add_lowerbounds (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph);
+PartialConstraintGraph generate_partial_lowerbound_graph (const ModelAnalysisContext& context , const PeriodicityVector& K) ;
 PartialConstraintGraph generate_partial_lowerbound_graph (const LETModel& model , const PeriodicityVector& K) ;
 
 
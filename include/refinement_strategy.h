@@ -0,0 +1,64 @@
+/*
+ * refinement_strategy.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_REFINEMENT_STRATEGY_H_
+#define INCLUDE_REFINEMENT_STRATEGY_H_
+
+#include <model.h>
+#include <periodicity_vector.h>
+#include <model_analysis_context.h>
+#include <functional>
+#include <vector>
+
+/**
+ * How ComputeAgeLatency chooses its periodicity vectors.
+ *
+ * initial gives the K of the first iteration. refine gets the K of the iteration, already raised by the
+ * critical path rule K[t] = lcm(K[t], N_P[t]), with its critical path, and returns the candidates of the
+ * next iteration. Candidates are raised again by the rule, so each one makes the path progress.
+ * With several candidates every one is evaluated and the one with the smallest upper bound is kept.
+ *
+ * Each K[t] must divide N[t], the empty functions stand for the critical path rule alone.
+ */
+typedef std::function<PeriodicityVector(const ModelAnalysisContext& context)> InitialPeriodicityFun;
+typedef std::function<std::vector<PeriodicityVector>(const ModelAnalysisContext& context, const PeriodicityVector& K, const std::vector<Execution>& path)> RefinePeriodicityFun;
+
+struct RefinementStrategy {
+	InitialPeriodicityFun initial;
+	RefinePeriodicityFun refine;
+};
+
+/**
+ * Original rule, only tasks of the critical path are raised.
+ */
+RefinementStrategy critical_path_refinement ();
+
+/**
+ * Tasks sharing a dependency with a task of the critical path are raised too, to the lcm of their period
+ * and the one of the path. Fewer iterations, larger expansions.
+ */
+RefinementStrategy neighbourhood_refinement ();
+
+/**
+ * Tasks with N[t] <= threshold start at K[t] = N[t], and tasks of the critical path with N[t] <= threshold
+ * jump straight to it. Nothing changes when the hyperperiod is unknown.
+ */
+RefinementStrategy small_n_refinement (EXECUTION_COUNT threshold = 8);
+
+/**
+ * The first K is the task-level estimate K[t] = lcm over dependencies (t, u) of lcm(T_t, T_u) / T_t,
+ * what the critical path rule would give to any two-task path through t.
+ */
+RefinementStrategy seeded_refinement ();
+
+/**
+ * The candidates of every strategy are evaluated together, the first one gives the initial K.
+ */
+RefinementStrategy speculative_refinement (const std::vector<RefinementStrategy>& strategies);
+
+
+#endif /* INCLUDE_REFINEMENT_STRATEGY_H_ */
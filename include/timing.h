@@ -0,0 +1,74 @@
+/*
+ * timing.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef INCLUDE_TIMING_H_
+#define INCLUDE_TIMING_H_
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Every duration of the library is measured on the steady clock, in milliseconds as a double.
+ */
+typedef std::chrono::steady_clock::time_point TimePoint;
+
+inline TimePoint now () { return std::chrono::steady_clock::now(); }
+inline double elapsed_ms (TimePoint from, TimePoint to) { return std::chrono::duration<double, std::milli>(to - from).count(); }
+inline double elapsed_ms (TimePoint from) { return elapsed_ms(from, now()); }
+
+/**
+ * How a function is measured: warmup untimed calls, then enough timed calls to last about target_time,
+ * within [min_repetitions, max_repetitions]. The first timed call is used for the calibration.
+ */
+struct MeasureOptions {
+	size_t warmup = 1;
+	double target_time = 0; // ms, 0 for min_repetitions calls
+	size_t min_repetitions = 1;
+	size_t max_repetitions = 1000;
+};
+
+/**
+ * Per call times in milliseconds and their summary. Statistics of several measures are merged with +.
+ */
+struct TimingStatistics {
+	std::vector<double> times;
+	double min = 0;
+	double median = 0;
+	double p90 = 0;
+	double mean = 0;
+	double stddev = 0;
+
+	TimingStatistics () {}
+	explicit TimingStatistics (std::vector<double> times);
+
+	inline size_t repetitions () const { return times.size(); }
+
+	friend std::ostream &operator<<(std::ostream &stream, const TimingStatistics &obj) {
+		stream << "min=" << obj.min
+				<< " median=" << obj.median
+				<< " p90=" << obj.p90
+				<< " mean=" << obj.mean
+				<< " stddev=" << obj.stddev
+				<< " reps=" << obj.repetitions();
+		return stream;
+	}
+};
+
+TimingStatistics operator+ (const TimingStatistics& l, const TimingStatistics& r);
+
+/**
+ * Times fun, setup runs untimed before every call (warm-up included) when the call consumes its input.
+ */
+TimingStatistics measure (const std::function<void()>& fun, const MeasureOptions& options = MeasureOptions(), const std::function<void()>& setup = nullptr);
+
+} // namespace utils
+
+#endif /* INCLUDE_TIMING_H_ */
@@ -10,6 +10,7 @@
 
 
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <vector>
 #include <map>
@@ -91,4 +92,56 @@ std::pair<entier,entier> extended_euclide (entier _a, entier _b, entier _c) {
 
 
 
+namespace utils {
+
+/**
+ * A begin/end pair seen as a read-only container, used to expose internal
+ * containers (or part of them) without copying.
+ */
+template <typename ITERATOR>
+class IteratorRange {
+	ITERATOR first, last;
+	size_t count;
+public:
+	IteratorRange(ITERATOR first, ITERATOR last, size_t count) : first(first), last(last), count(count) {}
+	inline ITERATOR begin() const { return first; }
+	inline ITERATOR end() const { return last; }
+	inline size_t size() const { return count; }
+	inline bool empty() const { return count == 0; }
+};
+
+/**
+ * Number of allocations done through CountingAllocator by the current thread.
+ */
+inline size_t& allocation_count() {
+	static thread_local size_t count = 0;
+	return count;
+}
+
+/**
+ * std::allocator that counts allocations, it equips the graph containers so
+ * that ComputeAgeLatency can report how many allocations an iteration needs.
+ */
+template <typename T>
+struct CountingAllocator {
+	typedef T value_type;
+
+	CountingAllocator() noexcept {}
+	template <typename U> CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+	inline T* allocate(std::size_t n) {
+		allocation_count()++;
+		return std::allocator<T>().allocate(n);
+	}
+	inline void deallocate(T* p, std::size_t n) noexcept {
+		std::allocator<T>().deallocate(p, n);
+	}
+
+	template <typename U> friend bool operator==(const CountingAllocator&, const CountingAllocator<U>&) { return true; }
+	template <typename U> friend bool operator!=(const CountingAllocator&, const CountingAllocator<U>&) { return false; }
+};
+
+} // namespace utils
+
+
 #endif /* SRC_INCLUDE_UTILS_H_ */
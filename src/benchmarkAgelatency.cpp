@@ -22,6 +22,20 @@ DEFINE_int32(iter_count,     50, "How many run per graph (precision)");
 DEFINE_int32(seed,          123, "Value of the first seed.");
 DEFINE_bool(detailed,      false, "printout every sample");
 DEFINE_string(kind,  "automotive", "Kind of dataset to generate (automotive,generic,harmonic)");
+DEFINE_string(engine, "expansion", "Critical path engine of ComputeAgeLatency (expansion,fused,maxplus,reduced,incremental)");
+DEFINE_string(refinement, "path", "K refinement strategy of ComputeAgeLatency (path,neighbourhood,small_n,seeded,speculative)");
+DEFINE_int32(speculative_threads, 1, "Threads evaluating the candidates of a refinement (0 for one per hardware thread)");
+DEFINE_bool(measure_checked, false, "Also time the analysis with the reference check and the lower bounds (chktime column)");
+DEFINE_bool(measure_gap,   false, "Also time the analysis stopping on the bound gap (gaptime, gapsaved and gapiter columns)");
+DEFINE_bool(measure_warm_start, false, "Also time a perturbed model from scratch and warm started (warmsaved and warmiter columns)");
+DEFINE_bool(measure_batch, false, "Also analyse every row with ComputeAgeLatencyBatch (batch column)");
+DEFINE_int32(batch_threads,   0, "Threads of the ComputeAgeLatencyBatch column (0 for one per hardware thread)");
+DEFINE_int32(jobs,            1, "Workers running the samples of a row (0 for one per hardware thread)");
+DEFINE_bool(pin_workers,   false, "Pin each sample worker to its own hardware thread");
+DEFINE_int32(warmup,          1, "Untimed runs before every measure");
+DEFINE_double(target_time,    0, "Calibrate the repetitions of every measure to last about that many milliseconds (0 for iter_count runs)");
+DEFINE_bool(percentiles,   false, "Print min, median, p90 and stddev of every measured function");
+DEFINE_string(format,     "text", "Output format (text,json,csv), json and csv report every sample");
 
 
 
@@ -46,6 +60,20 @@ int main (int argc , char * argv[]) {
 	config.seed          = FLAGS_seed;
 	config.kind          = str2kind(FLAGS_kind);
 	config.detailed      = FLAGS_detailed;
+	config.engine        = FLAGS_engine;
+	config.refinement    = FLAGS_refinement;
+	config.speculative_threads = FLAGS_speculative_threads;
+	config.measures.checked    = FLAGS_measure_checked;
+	config.measures.gap        = FLAGS_measure_gap;
+	config.measures.warm_start = FLAGS_measure_warm_start;
+	config.measure_batch = FLAGS_measure_batch;
+	config.batch_threads = FLAGS_batch_threads;
+	config.jobs          = FLAGS_jobs;
+	config.pin_workers   = FLAGS_pin_workers;
+	config.measure.warmup      = FLAGS_warmup;
+	config.measure.target_time = FLAGS_target_time;
+	config.percentiles   = FLAGS_percentiles;
+	config.format        = FLAGS_format;
 	main_benchmark_age_latency (config ) ;
 
 
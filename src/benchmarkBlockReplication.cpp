@@ -0,0 +1,49 @@
+/*
+ * benchmarkBlockReplication.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <verbose.h>
+#include <letitgo.h>
+#include <benchmark.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(verbose,         0, "Specify the verbosity level (0-10)");
+DEFINE_int32(begin_n,         5, "Minimal task count");
+DEFINE_int32(end_n,          20, "Maximum task count");
+DEFINE_int32(step_n,          5, "Step of task count");
+DEFINE_int32(sample_count,    5, "How many graph to generate per size (variety)");
+DEFINE_int32(iter_count,      3, "How many run per graph (precision)");
+DEFINE_int32(seed,          123, "Value of the first seed.");
+DEFINE_int32(k_divisor,       1, "K[t] = N[t] / gcd(N[t], k_divisor), 1 means K = N");
+DEFINE_string(kind,  "automotive", "Kind of dataset to generate (automotive,generic,harmonic)");
+
+
+int main (int argc , char * argv[]) {
+	gflags::SetUsageMessage("LETItGo: LET Analysis tool");
+	gflags::SetVersionString("1.0.0");
+	gflags::ParseCommandLineFlags(&argc, &argv, true);
+	utils::set_verbose_mode(FLAGS_verbose);
+
+
+	BlockReplicationBenchmarkConfiguration config;
+
+	config.begin_n       = FLAGS_begin_n;
+	config.end_n         = FLAGS_end_n;
+	config.step_n        = FLAGS_step_n;
+	config.sample_count  = FLAGS_sample_count;
+	config.iter_count    = FLAGS_iter_count;
+	config.seed          = FLAGS_seed;
+	config.detailed      = false;
+	config.kind          = str2kind(FLAGS_kind);
+	config.k_divisor     = FLAGS_k_divisor;
+
+	main_benchmark_block_replication ( config ) ;
+
+
+	gflags::ShutDownCommandLineFlags();
+	return 0;
+
+}
@@ -0,0 +1,54 @@
+/*
+ * benchmarkLongestPath.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <verbose.h>
+#include <letitgo.h>
+#include <benchmark.h>
+#include <gflags/gflags.h>
+#include <sstream>
+
+DEFINE_int32(verbose,         0, "Specify the verbosity level (0-10)");
+DEFINE_int32(begin_n,        10, "Minimal task count");
+DEFINE_int32(end_n,          50, "Maximum task count");
+DEFINE_int32(step_n,         10, "Step of task count");
+DEFINE_int32(sample_count,   10, "How many graph to generate per size (variety)");
+DEFINE_int32(iter_count,     10, "How many run per graph (precision)");
+DEFINE_int32(seed,          123, "Value of the first seed.");
+DEFINE_string(kind,  "automotive", "Kind of dataset to generate (automotive,generic,harmonic)");
+DEFINE_string(threads, "1,2,4,8,16,32", "Comma separated thread counts of the parallel longest path");
+
+
+int main (int argc , char * argv[]) {
+	gflags::SetUsageMessage("LETItGo: LET Analysis tool");
+	gflags::SetVersionString("1.0.0");
+	gflags::ParseCommandLineFlags(&argc, &argv, true);
+	utils::set_verbose_mode(FLAGS_verbose);
+
+
+	LongestPathBenchmarkConfiguration config;
+
+	config.begin_n       = FLAGS_begin_n;
+	config.end_n         = FLAGS_end_n;
+	config.step_n        = FLAGS_step_n;
+	config.sample_count  = FLAGS_sample_count;
+	config.iter_count    = FLAGS_iter_count;
+	config.seed          = FLAGS_seed;
+	config.kind          = str2kind(FLAGS_kind);
+
+	config.thread_counts.clear();
+	std::stringstream threads (FLAGS_threads);
+	for (std::string item ; std::getline(threads, item, ',') ; ) {
+		config.thread_counts.push_back(std::stoul(item));
+	}
+
+	main_benchmark_longest_path ( config ) ;
+
+
+	gflags::ShutDownCommandLineFlags();
+	return 0;
+
+}
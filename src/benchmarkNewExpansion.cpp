@@ -18,6 +18,13 @@ DEFINE_int32(step_n,          5, "Step of task count");
 DEFINE_int32(sample_count,  100, "How many graph to generate per size (variety)");
 DEFINE_int32(iter_count,     50, "How many run per graph (precision)");
 DEFINE_int32(seed,          123, "Value of the first seed.");
+DEFINE_int32(threads,         0, "Threads of the parallel expansion (0 for one per hardware thread)");
+DEFINE_int32(jobs,            1, "Workers running the samples of a row (0 for one per hardware thread)");
+DEFINE_bool(pin_workers,   false, "Pin each sample worker to its own hardware thread");
+DEFINE_int32(warmup,          1, "Untimed runs before every measure");
+DEFINE_double(target_time,    0, "Calibrate the repetitions of every measure to last about that many milliseconds (0 for iter_count runs)");
+DEFINE_bool(percentiles,   false, "Print min, median, p90 and stddev of every measured function");
+DEFINE_string(format,     "text", "Output format (text,json,csv), json and csv report every sample");
 
 
 
@@ -38,6 +45,13 @@ int main (int argc , char * argv[]) {
 	config.sample_count  = FLAGS_sample_count;
 	config.iter_count    = FLAGS_iter_count;
 	config.seed          = FLAGS_seed;
+	config.thread_count  = FLAGS_threads;
+	config.jobs          = FLAGS_jobs;
+	config.pin_workers   = FLAGS_pin_workers;
+	config.measure.warmup      = FLAGS_warmup;
+	config.measure.target_time = FLAGS_target_time;
+	config.percentiles   = FLAGS_percentiles;
+	config.format        = FLAGS_format;
 
 	main_benchmark_expansion ( config ) ;
 
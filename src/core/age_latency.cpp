@@ -7,91 +7,237 @@
 
 #include <model.h>
 #include <partial_constraint_graph.h>
-#include <repetition_vector.h>
 #include <utils.h>
 #include <age_latency.h>
+#include <parallel.h>
+#include <instrumentation.h>
 
 #include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <stack>
-#include <chrono>
+#include <timing.h>
+#include <future>
 
-// TODO: this ensure the graph generation is correct, and that the lower bound is correct.
-#define SUPERDBG
 
 
+AgeLatencyEngineFun expansion_engine (GenerateExpansionFun fun, bool verify_reference) {
+	return [fun, verify_reference] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		CriticalPathResult res;
 
-AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun fun) {
+		auto s1 = utils::now();
+		// Construct the PartialConstraintGraph and
+		PartialConstraintGraph PKG = fun(context, K);
+		auto s2 = utils::now();
+		if (verify_reference) {
+			VERBOSE_ASSERT_EQUALS(PKG, generate_partial_constraint_graph(context, K));
+		}
 
-	VERBOSE_INFO ("Run ComputeAgeLatency");
-	AgeLatencyResult res;
-	res.n = model.tasks().size();
-	res.m = model.dependencies().size();
+		// Find longest path and update the res
+		auto s3 = utils::now();
+		auto FLP = FindLongestPath(PKG);
+		auto s4 = utils::now();
+
+		res.path = std::move(FLP.first);
+		res.length = FLP.second;
+		res.vertex_count = PKG.getExecutions().size();
+		res.edge_count = PKG.getConstraints().size();
+		res.graph_computation_time = utils::elapsed_ms(s1, s2);
+		res.path_computation_time = utils::elapsed_ms(s3, s4);
+		return res;
+	};
+}
 
-	res.sum_n = compute_sum_n(model);
+AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun fun, const AgeLatencyOptions& options) {
+	return ComputeAgeLatencyWithEngine(model, expansion_engine(fun, options.verify_reference), options);
+}
 
+/**
+ * Raise K with the final K and critical path of an analysis of a close model. The model may have changed:
+ * tasks that do not exist anymore are skipped and a K[t] only keeps what still divides N[t].
+ */
+static void apply_warm_start (const ModelAnalysisContext& context, const PeriodicityVector& warm_K, const std::vector<Execution>& warm_path, PeriodicityVector& K) {
+	const bool known_n = context.getHyperperiod() != 0;
+	for (TASK_ID t = 0 ; t < (TASK_ID) std::min(K.size(), warm_K.size()) ; t++) {
+		const EXECUTION_COUNT k = known_n ? std::gcd(warm_K[t], (EXECUTION_COUNT) context.getN(t)) : warm_K[t];
+		K[t] = std::lcm(K[t], k);
+	}
 
-	bool NeedsToContinue = true;
-	PeriodicityVector K = generate_periodicity_vector(model);
+	INTEGER_TIME_UNIT T_P = 1;
+	for (const Execution& e : warm_path) {
+		if (e.first == -1 or (size_t) e.getTaskId() >= K.size()) continue;
+		T_P = std::lcm(T_P, context.getPeriod(e.getTaskId()));
+	}
+	for (const Execution& e : warm_path) {
+		if (e.first == -1 or (size_t) e.getTaskId() >= K.size()) continue;
+		K[e.getTaskId()] = std::lcm(K[e.getTaskId()], (EXECUTION_COUNT) (T_P / context.getPeriod(e.getTaskId())));
+	}
+	VERBOSE_AGE_LATENCY("Warm start K = " << K);
+}
 
-	while (NeedsToContinue) {
-		auto count = res.expansion_vertex_count.size();
-		VERBOSE_INFO ("Iteration" << count<< " Graph Generation");
+AgeLatencyResult ComputeAgeLatencyWithEngine(const LETModel &model, AgeLatencyEngineFun engine, const AgeLatencyOptions& options) {
 
-		auto s1 = std::chrono::high_resolution_clock::now();
-		// Construct the PartialConstraintGraph and
-		PartialConstraintGraph PKG = fun(model, K);
-		auto s2 = std::chrono::high_resolution_clock::now();
-#ifdef SUPERDBG
-		// TODO: Check against reference, Remove for real experiments
-		VERBOSE_ASSERT_EQUALS(PKG, generate_partial_constraint_graph(model, K));
-#endif
+	VERBOSE_INFO ("Run ComputeAgeLatency");
+	const auto start = utils::now();
+	InstrumentationScope instrumentation;
 
-		VERBOSE_INFO ("Iteration" << count  << " Find Longest Path");
+	// Everything that only depends on the model is computed once for all the iterations.
+	const ModelAnalysisContext context (model);
 
-		// Find longest path and update the res
-		auto s3 = std::chrono::high_resolution_clock::now();
-		auto FLP = FindLongestPath(PKG);
-		auto s4 = std::chrono::high_resolution_clock::now();
+	AgeLatencyResult res;
+	res.n = context.getTaskCount();
+	res.m = context.getDependencyCount();
 
-		auto P = FLP.first;
-		res.upper_bounds.push_back(FLP.second);
-		res.expansion_vertex_count.push_back(PKG.getExecutions().size());
-		res.expansion_edge_count.push_back(PKG.getConstraints().size());
-		res.age_latency = FLP.second;
+	// sum_n is left to 0 when the hyperperiod does not fit in INTEGER_TIME_UNIT.
+	res.sum_n = context.getSumN();
+	res.context_setup_time = context.getSetupTime();
+	LETITGO_INSTRUMENT(InstrumentationCounters::local().phase_time["context_setup"] += res.context_setup_time);
 
-		res.graph_computation_time += (s2-s1).count() / 1000000;
-		res.path_computation_time += (s4-s3).count() / 1000000;
+	auto out_of_budget = [&options, &start] () {
+		return options.time_budget > 0
+				and utils::elapsed_ms(start) >= options.time_budget;
+	};
 
-#ifdef SUPERDBG
-		VERBOSE_INFO ("Iteration" << count  << " Lower bound Graph Generation");
-		// Compute the lower bound to check it is lower than the uppoer bound.
-		auto pbgbis = generate_partial_lowerbound_graph(model, K);
-		VERBOSE_INFO ("Iteration" << count << " Lower bound Find Longest Path");
-		auto lower_bound = FindLongestPath(pbgbis);
-		VERBOSE_AGE_LATENCY(" * FindLongestPath(PKG) = " << FLP);
+	const RefinementStrategy& strategy = options.refinement;
+	bool NeedsToContinue = true;
+	PeriodicityVector K;
+	std::vector<PeriodicityVector> candidates = {strategy.initial ? strategy.initial(context) : generate_periodicity_vector(model)};
+	if (not options.warm_start_K.empty() or not options.warm_start_path.empty()) {
+		apply_warm_start(context, options.warm_start_K, options.warm_start_path, candidates.front());
+	}
 
+	while (NeedsToContinue) {
+		const size_t count = res.iterations++;
+		VERBOSE_INFO ("Iteration" << count<< " Find Longest Path");
+		const size_t allocations = utils::allocation_count();
+
+		// The lower bound does not depend on the engine, both bounds can be solved together.
+		// Any K gives a lower bound, the first candidate is used.
+		const PeriodicityVector& lower_K = candidates.front();
+		auto solve_lower_bound = [&context, &lower_K, count] () {
+			VERBOSE_INFO ("Iteration" << count  << " Lower bound Graph Generation");
+			auto pbgbis = generate_partial_lowerbound_graph(context, lower_K);
+			VERBOSE_INFO ("Iteration" << count << " Lower bound Find Longest Path");
+			return FindLongestPath(pbgbis);
+		};
+		// The instrumentation counters and allocations of the second thread are merged back once it is done.
+		struct ConcurrentLowerBound {
+			std::pair<std::vector<Execution>, INTEGER_TIME_UNIT> bound;
+			InstrumentationCounters counters;
+			size_t allocations = 0;
+		};
+		std::future<ConcurrentLowerBound> concurrent_lower_bound;
+		if (options.needs_lower_bound() and options.concurrent_bounds) {
+			concurrent_lower_bound = std::async(std::launch::async, [&solve_lower_bound] () {
+				ConcurrentLowerBound res;
+				const size_t allocations = utils::allocation_count();
+				InstrumentationScope scope;
+				res.bound = solve_lower_bound();
+				res.counters = scope.collect();
+				res.allocations = utils::allocation_count() - allocations;
+				return res;
+			});
+		}
 
+		// Only the allocations of the calling thread are counted when candidates are evaluated in parallel,
+		// the instrumentation counters of the workers are merged back.
+		std::vector<CriticalPathResult> results (candidates.size());
+		{
+			LETITGO_PHASE_TIMER("critical_path");
+			if (candidates.size() == 1 or options.speculative_threads == 1) {
+				for (size_t c = 0 ; c < candidates.size() ; c++) results[c] = engine(context, candidates[c]);
+			} else {
+				std::vector<InstrumentationCounters> counters (candidates.size());
+				utils::parallel_for(candidates.size(), options.speculative_threads, [&] (size_t c) {
+					InstrumentationScope scope;
+					results[c] = engine(context, candidates[c]);
+					counters[c] = scope.collect();
+					InstrumentationCounters::local().clear();
+				});
+				for (const InstrumentationCounters& c : counters) InstrumentationCounters::local() += c;
+			}
+		}
+
+		// The tightest upper bound is kept, the first one on ties.
+		size_t best = 0;
+		TIME_UNIT graph_computation_time = 0, path_computation_time = 0;
+		for (size_t c = 0 ; c < results.size() ; c++) {
+			graph_computation_time += results[c].graph_computation_time;
+			path_computation_time += results[c].path_computation_time;
+			res.reduction_time += results[c].reduction_time;
+			if (results[c].length < results[best].length) best = c;
+		}
+		res.graph_computation_time += graph_computation_time;
+		res.path_computation_time += path_computation_time;
+		K = candidates[best];
+		const CriticalPathResult& FLP = results[best];
+		VERBOSE_AGE_LATENCY("Candidate " << best << " of " << candidates.size() << " kept, K = " << K);
+
+		const std::vector<Execution>& P = FLP.path;
+		res.age_latency = FLP.length;
+		res.periodicity_vector = K;
+		res.critical_path = P;
+		res.best_upper_bound = (count == 0) ? FLP.length : std::min(res.best_upper_bound, FLP.length);
+
+		if (options.collect_statistics) {
+			res.allocation_count.push_back(utils::allocation_count() - allocations);
+			res.candidate_count.push_back(candidates.size());
+			res.graph_computation_times.push_back(graph_computation_time);
+			res.path_computation_times.push_back(path_computation_time);
+			res.upper_bounds.push_back(FLP.length);
+			res.expansion_vertex_count.push_back(FLP.vertex_count);
+			res.expansion_edge_count.push_back(FLP.edge_count);
+			res.reused_dependency_count.push_back(FLP.reused_dependencies);
+			if (FLP.reduced) {
+				res.reduced_vertex_count.push_back(FLP.reduced_vertex_count);
+				res.reduced_edge_count.push_back(FLP.reduced_edge_count);
+			}
+		}
+
+		if (options.verify_reference) {
+			// The engine must find the bound of the reference expansion.
+			VERBOSE_ASSERT_EQUALS(FLP.length, FindLongestPath(generate_partial_constraint_graph(context, K)).second);
+		}
 
-		VERBOSE_AGE_LATENCY(" * bound = " << lower_bound << " <= " << FLP);
-		VERBOSE_ASSERT(lower_bound.second <= FLP.second, "The lower bound function does not work");
+		if (options.needs_lower_bound()) {
+			// Compute the lower bound to check it is lower than the uppoer bound.
+			std::pair<std::vector<Execution>, INTEGER_TIME_UNIT> lower_bound;
+			if (options.concurrent_bounds) {
+				ConcurrentLowerBound concurrent = concurrent_lower_bound.get();
+				lower_bound = std::move(concurrent.bound);
+				InstrumentationCounters::local() += concurrent.counters;
+				utils::allocation_count() += concurrent.allocations;
+			} else {
+				lower_bound = solve_lower_bound();
+			}
+			VERBOSE_AGE_LATENCY(" * FindLongestPath(PKG) = " << FLP.path << " " << FLP.length);
+			VERBOSE_AGE_LATENCY(" * bound = " << lower_bound << " <= " << FLP.length);
+			VERBOSE_ASSERT(lower_bound.second <= FLP.length, "The lower bound function does not work");
 
-		res.lower_bounds.push_back(lower_bound.second);
-#endif
+			res.best_lower_bound = (count == 0) ? lower_bound.second : std::max(res.best_lower_bound, lower_bound.second);
+			res.lower_bounds.push_back(lower_bound.second);
+		}
+
+		// Both bounds met, or close enough, the best upper bound is the answer whatever the path says.
+		const INTEGER_TIME_UNIT gap = res.best_upper_bound - res.best_lower_bound;
+		if ((options.stop_on_bound_gap or options.is_anytime())
+				and (double) gap <= options.epsilon * (double) res.best_upper_bound) {
+			VERBOSE_AGE_LATENCY("Bounds [" << res.best_lower_bound << "," << res.best_upper_bound << "] met after " << res.iterations << " iterations");
+			res.age_latency = res.best_upper_bound;
+			res.closed_by_bounds = true;
+			res.status = (gap <= 0) ? AgeLatencyStatus::exact : AgeLatencyStatus::within_epsilon;
+			NeedsToContinue = false;
+			continue;
+		}
 
 		VERBOSE_INFO ("Iteration" << count  << " Conclude");
 
 		INTEGER_TIME_UNIT T_P = 1;
 
-		for (Execution e : P) {
+		for (const Execution& e : P) {
 			if (e.first == -1)
 				continue;
-			auto tid = e.getTaskId();
-			auto task = model.getTaskById(tid);
-			auto taskT = task.getT();
-			VERBOSE_ASSERT(taskT > 0, "task.T Cannot be null");
-			T_P = std::lcm(T_P, taskT);
+			T_P = std::lcm(T_P, context.getPeriod(e.getTaskId()));
 		}
 
 		VERBOSE_ASSERT(T_P > 0, "T_P Cannot be null");
@@ -99,19 +245,17 @@ AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun f
 		// COmpute N[T]
 		std::map<TASK_ID, INTEGER_TIME_UNIT> N;
 
-		for (Execution e : P) {
+		for (const Execution& e : P) {
 			if (e.first == -1)
 				continue;
 			auto tid = e.getTaskId();
-			auto task = model.getTaskById(tid);
-			auto taskT = task.getT();
-			N[tid] = (T_P / taskT);
+			N[tid] = (T_P / context.getPeriod(tid));
 
 		}
 
 		// we check the critical cycle is max
 		NeedsToContinue = false;
-		for (Execution e : P) {
+		for (const Execution& e : P) {
 			if (e.first == -1)
 				continue;
 			auto tid = e.getTaskId();
@@ -125,10 +269,21 @@ AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun f
 		}
 
 		if (!NeedsToContinue) {
+			res.best_lower_bound = res.age_latency;
 			continue;
 		}
 
-		for (Execution e : P) {
+		if ((options.max_iterations > 0 and res.iterations >= options.max_iterations) or out_of_budget()) {
+			VERBOSE_AGE_LATENCY("Truncated after " << res.iterations << " iterations with bounds [" << res.best_lower_bound << "," << res.best_upper_bound << "]");
+			res.age_latency = res.best_upper_bound;
+			res.status = AgeLatencyStatus::truncated;
+			NeedsToContinue = false;
+			continue;
+		}
+
+		LETITGO_PHASE_TIMER("refinement");
+
+		for (const Execution& e : P) {
 			if (e.first == -1)
 				continue;
 			auto tid = e.getTaskId();
@@ -136,8 +291,17 @@ AgeLatencyResult ComputeAgeLatency(const LETModel &model, GenerateExpansionFun f
 			VERBOSE_AGE_LATENCY("NiP|Ki = " << N[tid] << "|" << K[tid] << " will be "
 					<< std::lcm(K[tid], N[tid]));
 		}
+
+		candidates = strategy.refine ? strategy.refine(context, K, P) : std::vector<PeriodicityVector>();
+		if (candidates.empty()) candidates.push_back(K);
+		for (PeriodicityVector& candidate : candidates) {
+			for (TASK_ID t = 0 ; t < (TASK_ID) K.size() ; t++) candidate[t] = std::lcm(candidate[t], K[t]);
+		}
 	}
 
+	res.total_time = utils::elapsed_ms(start);
+	res.instrumentation = instrumentation.collect();
+
 	VERBOSE_AGE_LATENCY("Final K = " << K);
 	VERBOSE_DEBUG("Final Age latency = " << res.age_latency);
 
@@ -0,0 +1,42 @@
+/*
+ * age_latency_batch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <age_latency.h>
+#include <parallel.h>
+#include <integer_arithmetic.h>
+#include <numeric>
+#include <limits>
+
+/**
+ * The iterations expand up to sum N executions, models whose hyperperiod overflows come first.
+ * Only the periods are read, the context of a model is built by its own analysis.
+ */
+static double estimate_analysis_cost (const LETModel& model) {
+	utils::wide_integer hyperperiod = 1;
+	for (const Task& t : model.tasks()) {
+		if (t.getT() <= 0) return std::numeric_limits<double>::max();
+		hyperperiod = hyperperiod / std::gcd((INTEGER_TIME_UNIT) (hyperperiod % t.getT()), t.getT()) * t.getT();
+		if (hyperperiod > std::numeric_limits<INTEGER_TIME_UNIT>::max()) return std::numeric_limits<double>::max();
+	}
+	double sum_n = 0;
+	for (const Task& t : model.tasks()) sum_n += (double) (hyperperiod / t.getT());
+	return sum_n + (double) model.getDependencyCount();
+}
+
+std::vector<AgeLatencyResult> ComputeAgeLatencyBatch(const std::vector<LETModel>& models, const AgeLatencyOptions& options, size_t thread_count, AgeLatencyFun fun, GenerateExpansionFun expansion) {
+
+	std::vector<double> costs (models.size());
+	for (size_t i = 0 ; i < models.size() ; i++) costs[i] = estimate_analysis_cost(models[i]);
+
+	std::vector<AgeLatencyResult> results (models.size());
+	const size_t stolen = utils::work_stealing_for(costs, thread_count, [&] (size_t i, size_t) {
+		results[i] = fun(models[i], expansion, options);
+	});
+	VERBOSE_INFO ("Batch of " << models.size() << " models done, " << stolen << " stolen");
+
+	return results;
+}
@@ -0,0 +1,123 @@
+/*
+ * block_replication_expansion.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <block_replication.h>
+#include <model_analysis_context.h>
+#include <algorithm2.h>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+
+/**
+ * new_algorithm2 sink that keeps the constraints of the base rows.
+ */
+struct BlockRecorder {
+	struct Entry {
+		EXECUTION_COUNT ai;
+		EXECUTION_COUNT aj;
+		WEIGHT weight;
+		inline friend bool operator< (const Entry& l, const Entry& r) { return std::tie(l.ai, l.aj, l.weight) < std::tie(r.ai, r.aj, r.weight); }
+	};
+	std::vector<Entry> entries;
+	inline void add(const Constraint& c) {
+		entries.push_back({c.getSource().second, c.getDestination().second, c.getWeight()});
+	}
+};
+
+/**
+ * The edges [first_edge, first_edge + count) end the builder, append copies - 1 copies of them,
+ * copy c with ids shifted by c * (source_step, destination_step). Each pass doubles what it copies.
+ */
+static void append_copies (CompactConstraintGraphBuilder& builder, size_t first_edge, size_t count, EXECUTION_COUNT copies, long source_step, long destination_step) {
+	VERBOSE_ASSERT(first_edge + count == builder.getEdgeCount(), "Only the last edges can be copied");
+	for (EXECUTION_COUNT done = 1 ; done < copies ; ) {
+		const EXECUTION_COUNT todo = std::min(done, copies - done);
+		builder.replicate(first_edge, todo * count, done * source_step, done * destination_step);
+		done += todo;
+	}
+}
+
+/**
+ * Expands the dependency did into the builder, Algorithm 2 only runs on its base rows.
+ */
+static void add_replicated_constraints (const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, CompactConstraintGraphBuilder& builder) {
+
+	const DependencyConstants& d = context.getDependency(did);
+	const Theorem6Kernel kernel = context.getKernel(did, K);
+	const ConstraintBlock block (kernel);
+	const EXECUTION_COUNT Ki = K[d.ti];
+	const EXECUTION_COUNT Kj = K[d.tj];
+
+	VERBOSE_ASSERT(Ki % block.rows == 0 and Kj % block.columns == 0, "Row and column periods must divide Ki and Kj");
+	VERBOSE_BRE("Dependency " << did << " Ki=" << Ki << " Kj=" << Kj << " rows=" << block.rows << " columns=" << block.columns
+			<< " lattice=(" << block.lattice_rows << "," << block.lattice_columns << ") base_rows=" << block.base_rows);
+
+	// Nothing to replicate, the base rows are the whole grid.
+	if (block.base_rows == Ki and block.columns == Kj) {
+		new_algorithm2(d.ti, d.tj, kernel, Ki, Kj, builder, 1, Ki);
+		return;
+	}
+
+	// 1) Base rows over one column period, with the gcdK of (Ki, Kj).
+	BlockRecorder recorder;
+	new_algorithm2(d.ti, d.tj, kernel, block.base_rows, block.columns, recorder, 1, block.base_rows);
+	if (recorder.entries.empty()) return;
+	std::sort(recorder.entries.begin(), recorder.entries.end());
+
+	std::vector<size_t> row_first (block.base_rows + 2, 0); // entries of base row r are [row_first[r], row_first[r + 1])
+	for (const BlockRecorder::Entry& e : recorder.entries) row_first[e.ai + 1]++;
+	std::partial_sum(row_first.begin(), row_first.end(), row_first.begin());
+
+	const EXECUTION_ID ti_first = builder.getExecutionId(Execution(d.ti, 1));
+	const EXECUTION_ID tj_first = builder.getExecutionId(Execution(d.tj, 1));
+
+	// 2) Rows 1..rows, one column period each then copied along aj. Rows are sparse out of case 1,
+	//    so the period is appended edge by edge and only the copies go through replicate.
+	const size_t first_edge = builder.getEdgeCount();
+	for (EXECUTION_COUNT ai = 1 ; ai <= block.rows ; ai++) {
+		const size_t period_edge = builder.getEdgeCount();
+		const EXECUTION_COUNT r = (ai - 1) % block.lattice_rows + 1;
+		const size_t count = row_first[r + 1] - row_first[r];
+		if (count == 0) continue;
+
+		// Row r rotated by k * lattice_columns along aj, the entries pushed past the period wrap around.
+		const EXECUTION_COUNT k = (ai - 1) / block.lattice_rows;
+		const EXECUTION_COUNT shift = (k % block.columns) * block.lattice_columns % block.columns;
+		const EXECUTION_ID src = ti_first + (EXECUTION_ID) (ai - 1);
+		for (size_t e = row_first[r] ; e < row_first[r + 1] ; e++) {
+			const BlockRecorder::Entry& entry = recorder.entries[e];
+			const EXECUTION_COUNT aj = (entry.aj + shift > block.columns) ? entry.aj + shift - block.columns : entry.aj + shift;
+			builder.add(src, tj_first + (EXECUTION_ID) (aj - 1), entry.weight);
+		}
+		append_copies(builder, period_edge, count, Kj / block.columns, 0, block.columns);
+	}
+
+	// 3) Copies of rows 1..rows along ai.
+	append_copies(builder, first_edge, builder.getEdgeCount() - first_edge, Ki / block.rows, block.rows, 0);
+}
+
+CompactConstraintGraph block_generate_compact_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+
+	const LETModel& model = context.getModel();
+	CompactConstraintGraphBuilder builder (model, K);
+
+	VERBOSE_BRE("1) Create constraints.");
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		add_replicated_constraints(context, K, did, builder);
+	}
+
+	VERBOSE_BRE("2) Constraints done, add start and finish.");
+	add_start_finish (model, K, builder);
+
+	return builder.build();
+}
+
+CompactConstraintGraph block_generate_compact_constraint_graph (const LETModel &model, const PeriodicityVector &K) {
+	const ModelAnalysisContext context (model);
+	return block_generate_compact_constraint_graph(context, K);
+}
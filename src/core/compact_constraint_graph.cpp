@@ -0,0 +1,242 @@
+/*
+ * compact_constraint_graph.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <compact_constraint_graph.h>
+#include <algorithm2.h>
+#include <utils.h>
+#include <algorithm>
+#include <numeric>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_CCG(m) VERBOSE_CUSTOM_DEBUG("CCG", m)
+#else
+#define VERBOSE_CCG(m) {}
+#endif
+
+
+size_t CompactConstraintGraph::memory_footprint() const {
+	return task_offsets.capacity() * sizeof(size_t)
+			+ (out_offsets.capacity() + in_offsets.capacity()) * sizeof(size_t)
+			+ (out_destinations.capacity() + in_sources.capacity()) * sizeof(EXECUTION_ID)
+			+ (out_weights.capacity() + in_weights.capacity()) * sizeof(WEIGHT);
+}
+
+
+CompactConstraintGraphBuilder::CompactConstraintGraphBuilder (const LETModel &model, const PeriodicityVector &K) {
+	graph.task_offsets.resize(model.getTaskCount() + 1);
+	size_t offset = 2; // s and f
+	for (size_t tid = 0 ; tid < model.getTaskCount(); tid++) {
+		graph.task_offsets[tid] = offset;
+		offset += K[tid];
+	}
+	graph.task_offsets[model.getTaskCount()] = offset;
+	VERBOSE_ASSERT(offset <= std::numeric_limits<EXECUTION_ID>::max(), "Too many executions for EXECUTION_ID");
+}
+
+
+CompactConstraintGraph CompactConstraintGraphBuilder::build() {
+
+	const size_t V = getVertexCount();
+	const size_t E = sources.size();
+
+	VERBOSE_CCG("Build CSR with V=" << V << " and E=" << E);
+
+	// 1) Counting sort of the edge list by source.
+	std::vector<size_t> out_offsets (V + 1, 0);
+	for (EXECUTION_ID src : sources) out_offsets[src + 1]++;
+	std::partial_sum(out_offsets.begin(), out_offsets.end(), out_offsets.begin());
+
+	std::vector<std::pair<EXECUTION_ID, WEIGHT>> out_edges (E);
+	{
+		std::vector<size_t> cursor (out_offsets.begin(), out_offsets.end() - 1);
+		for (size_t e = 0 ; e < E ; e++) {
+			out_edges[cursor[sources[e]]++] = std::make_pair(destinations[e], weights[e]);
+		}
+	}
+	std::vector<EXECUTION_ID>().swap(sources);
+	std::vector<EXECUTION_ID>().swap(destinations);
+	std::vector<WEIGHT>().swap(weights);
+
+	// 2) Sort each row by (destination, weight) and merge identical constraints.
+	graph.out_offsets.assign(V + 1, 0);
+	size_t kept = 0;
+	for (size_t v = 0 ; v < V ; v++) {
+		auto first = out_edges.begin() + out_offsets[v];
+		auto last  = out_edges.begin() + out_offsets[v + 1];
+		std::sort(first, last);
+		last = std::unique(first, last);
+		for (auto it = first ; it != last ; it++) {
+			out_edges[kept++] = *it;
+		}
+		graph.out_offsets[v + 1] = kept;
+	}
+	out_edges.resize(kept);
+
+	graph.out_destinations.resize(kept);
+	graph.out_weights.resize(kept);
+	for (size_t e = 0 ; e < kept ; e++) {
+		graph.out_destinations[e] = out_edges[e].first;
+		graph.out_weights[e]      = out_edges[e].second;
+	}
+	std::vector<std::pair<EXECUTION_ID, WEIGHT>>().swap(out_edges);
+
+	// 3) Transpose, rows are visited by increasing source so inbounds end up sorted by (source, weight).
+	graph.in_offsets.assign(V + 1, 0);
+	for (EXECUTION_ID dst : graph.out_destinations) graph.in_offsets[dst + 1]++;
+	std::partial_sum(graph.in_offsets.begin(), graph.in_offsets.end(), graph.in_offsets.begin());
+
+	graph.in_sources.resize(kept);
+	graph.in_weights.resize(kept);
+	{
+		std::vector<size_t> cursor (graph.in_offsets.begin(), graph.in_offsets.end() - 1);
+		for (size_t v = 0 ; v < V ; v++) {
+			for (size_t e = graph.out_offsets[v] ; e < graph.out_offsets[v + 1] ; e++) {
+				const size_t pos = cursor[graph.out_destinations[e]]++;
+				graph.in_sources[pos] = v;
+				graph.in_weights[pos] = graph.out_weights[e];
+			}
+		}
+	}
+
+	graph.execution_count = 0;
+	for (size_t v = 0 ; v < V ; v++) {
+		if (graph.getInputCount(v) + graph.getOutputCount(v) > 0) graph.execution_count++;
+	}
+
+	CompactConstraintGraph res;
+	std::swap(res, graph);
+	return res;
+}
+
+
+void add_start_finish (const LETModel &model, const PeriodicityVector &K, CompactConstraintGraphBuilder& builder) {
+
+	const size_t V = builder.getVertexCount();
+	std::vector<bool> has_input (V, false);
+	std::vector<bool> has_output (V, false);
+	for (EXECUTION_ID src : builder.getSources()) has_output[src] = true;
+	for (EXECUTION_ID dst : builder.getDestinations()) has_input[dst] = true;
+
+	for (const Task& task : model.tasks()) {
+		const TASK_ID tid = task.getId();
+		const WEIGHT Di = task.getD();
+		for (EXECUTION_COUNT a = 1 ; a <= K[tid] ; a++) {
+			const EXECUTION_ID t = builder.getExecutionId(Execution(tid, a));
+
+			// for any t without pred add s-> t with weight 0
+			if (not has_input[t]) {
+				builder.add(CompactConstraintGraph::START, t, 0);
+			}
+
+			// for any t without succ add t -> f with weight Di (i the task)
+			if (not has_output[t]) {
+				builder.add(t, CompactConstraintGraph::FINISH, Di);
+			}
+		}
+	}
+}
+
+
+CompactConstraintGraph generate_compact_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+
+	const LETModel& model = context.getModel();
+	CompactConstraintGraphBuilder builder (model, K);
+
+	VERBOSE_CCG("1) Create constraints.");
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		new_algorithm2(context, K , did, builder) ;
+	}
+
+	VERBOSE_CCG("2) Constraints done, add start and finish.");
+	add_start_finish (model, K, builder);
+
+	return builder.build();
+}
+
+CompactConstraintGraph generate_compact_constraint_graph (const LETModel &model, const PeriodicityVector &K) {
+	const ModelAnalysisContext context (model);
+	return generate_compact_constraint_graph(context, K);
+}
+
+
+/**
+ * Same Kahn order as topologicalOrder(PartialConstraintGraph): a stack seeded with s,
+ * outbounds visited by increasing (destination, weight). Both FindLongestPath then
+ * return the very same path.
+ */
+static std::vector<EXECUTION_ID> compactTopologicalOrder(const CompactConstraintGraph& PKG) {
+
+	const size_t V = PKG.getVertexCount();
+	std::vector<size_t> remaining (V);
+	for (size_t v = 0 ; v < V ; v++) remaining[v] = PKG.getInputCount(v);
+
+	std::vector<EXECUTION_ID> L;
+	L.reserve(V);
+	std::vector<EXECUTION_ID> S = {CompactConstraintGraph::START};
+
+	while (S.size()) {
+		const EXECUTION_ID n = S.back();
+		S.pop_back();
+		L.push_back(n);
+		for (size_t e = PKG.outBegin(n) ; e < PKG.outEnd(n) ; e++) {
+			const EXECUTION_ID m = PKG.getOutDestination(e);
+			if (--remaining[m] == 0) {
+				S.push_back(m);
+			}
+		}
+	}
+
+	return L;
+}
+
+std::vector<Execution> topologicalOrder (const CompactConstraintGraph& PKG) {
+	std::vector<Execution> L;
+	for (EXECUTION_ID id : compactTopologicalOrder(PKG)) {
+		L.push_back(PKG.getExecution(id));
+	}
+	return L;
+}
+
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  FindLongestPath(const CompactConstraintGraph& PKG) {
+
+	const size_t V = PKG.getVertexCount();
+	const EXECUTION_ID none = std::numeric_limits<EXECUTION_ID>::max();
+
+	std::vector<WEIGHT> dist (V, 0);
+	std::vector<bool>   reached (V, false);
+	std::vector<EXECUTION_ID> prev (V, none);
+
+	reached[CompactConstraintGraph::START] = true;
+
+	for (EXECUTION_ID src : compactTopologicalOrder(PKG)) {
+		if (not reached[src]) {
+			VERBOSE_ERROR("Topological order failed");
+			continue;
+		}
+		for (size_t e = PKG.outBegin(src) ; e < PKG.outEnd(src) ; e++) {
+			const EXECUTION_ID dest = PKG.getOutDestination(e);
+			const WEIGHT candidate = dist[src] + PKG.getOutWeight(e);
+			if (not reached[dest] or dist[dest] < candidate) {
+				dist[dest] = candidate;
+				reached[dest] = true;
+				prev[dest] = src;
+			}
+		}
+	}
+
+	std::vector<Execution> L;
+	EXECUTION_ID e = CompactConstraintGraph::FINISH;
+	while (prev[e] != none) {
+		L.push_back(PKG.getExecution(e));
+		e = prev[e];
+	}
+	L.push_back(PKG.getExecution(e));
+
+	std::reverse(L.begin(), L.end());
+
+	return std::pair<std::vector<Execution>, INTEGER_TIME_UNIT>(L, dist[CompactConstraintGraph::FINISH]);
+}
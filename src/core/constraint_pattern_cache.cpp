@@ -0,0 +1,90 @@
+/*
+ * constraint_pattern_cache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <constraint_pattern_cache.h>
+#include <mutex>
+
+
+const ConstraintPattern& ConstraintPatternCache::lookup (const ConstraintPatternKey& key, TASK_ID ti_id, TASK_ID tj_id, const Theorem6Kernel& kernel, ConstraintPattern& scratch) {
+
+	stats.lookups++;
+	auto it = patterns.find(key);
+	if (it != patterns.end()) {
+		stats.hits++;
+		return it->second;
+	}
+
+	// What Algorithm 2 counted is kept apart, expand() replays it on every use of the pattern.
+	{
+		InstrumentationScope scope;
+		Recorder recorder = {scratch, kernel.rjmripTimTj};
+		new_algorithm2(ti_id, tj_id, kernel, key.Ki, key.Kj, recorder, 1, key.Ki);
+		scratch.stats = scope.collect();
+		InstrumentationCounters::local().clear();
+	}
+	scratch.entries.shrink_to_fit();
+
+	const size_t bytes = scratch.memory_footprint();
+	if (max_bytes and stats.bytes + bytes > max_bytes) {
+		VERBOSE_CPC("Cache full, pattern of " << scratch.entries.size() << " constraints not stored");
+		return scratch;
+	}
+
+	stats.patterns++;
+	stats.bytes += bytes;
+	return patterns.emplace(key, std::move(scratch)).first->second;
+}
+
+void ConstraintPatternCache::clear () {
+	patterns.clear();
+	stats.clear();
+}
+
+
+PartialConstraintGraph generate_partial_constraint_graph_with_cache (const ModelAnalysisContext &context, const PeriodicityVector &K, ConstraintPatternCache& cache) {
+
+	PartialConstraintGraph graph;
+	const LETModel& model = context.getModel();
+	LETITGO_INSTRUMENT(const PatternCache_statistics before = cache.getStatistics();)
+
+	VERBOSE_CPC("1) Create constraints.");
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		cache.expand(context, K, did, graph);
+	}
+	LETITGO_INSTRUMENT(InstrumentationCounters::local().pattern_cache += cache.getStatistics() - before;)
+
+	VERBOSE_CPC("2) Constraints done, add start and finish.");
+	add_start_finish (model, K, graph);
+	return graph;
+}
+
+PartialConstraintGraph generate_partial_constraint_graph_with_cache (const LETModel &model, const PeriodicityVector &K, ConstraintPatternCache& cache) {
+	const ModelAnalysisContext context (model);
+	return generate_partial_constraint_graph_with_cache(context, K, cache);
+}
+
+PartialConstraintGraph cached_generate_partial_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+
+	ConstraintPatternCache cache;
+	PartialConstraintGraph graph = generate_partial_constraint_graph_with_cache(context, K, cache);
+	VERBOSE_CPC("Pattern cache " << cache.getStatistics());
+	return graph;
+}
+
+PartialConstraintGraph cached_generate_partial_constraint_graph (const LETModel &model, const PeriodicityVector &K) {
+	const ModelAnalysisContext context (model);
+	return cached_generate_partial_constraint_graph(context, K);
+}
+
+GenerateExpansionFun pattern_cache_expansion (std::shared_ptr<ConstraintPatternCache> cache) {
+	auto mutex = std::make_shared<std::mutex>();
+	return [cache, mutex] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		// Speculative candidates may come from several threads, the cache is not thread-safe.
+		const std::lock_guard<std::mutex> lock (*mutex);
+		return generate_partial_constraint_graph_with_cache(context, K, *cache);
+	};
+}
@@ -0,0 +1,151 @@
+/*
+ * fused_expansion.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <age_latency.h>
+#include <algorithm2.h>
+#include <utils.h>
+#include <algorithm>
+#include <timing.h>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_FUSED(m) VERBOSE_CUSTOM_DEBUG("FUSED", m)
+#else
+#define VERBOSE_FUSED(m) {}
+#endif
+
+
+/**
+ * Longest path state, one entry per execution (task, a), a in [1,K[task]].
+ * It is also the sink of new_algorithm2, every constraint is relaxed straight away.
+ */
+class FusedRelaxation {
+
+	const Execution none = Execution(-1, -1);
+
+	std::vector<std::vector<WEIGHT>>    dist;
+	std::vector<std::vector<Execution>> prev;
+	std::vector<std::vector<bool>>      has_input;
+	std::vector<std::vector<bool>>      has_output;
+
+public:
+	size_t relaxed = 0;
+
+	FusedRelaxation (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		const size_t n = context.getTaskCount();
+		dist.resize(n);
+		prev.resize(n);
+		has_input.resize(n);
+		has_output.resize(n);
+		for (size_t tid = 0 ; tid < n ; tid++) {
+			dist[tid].assign(K[tid], 0);
+			prev[tid].assign(K[tid], none);
+			has_input[tid].assign(K[tid], false);
+			has_output[tid].assign(K[tid], false);
+		}
+	}
+
+	/**
+	 * Sources of c belong to a task already closed (all its inputs were relaxed).
+	 */
+	inline void add(const Constraint& c) {
+		const Execution& src = c.getSource();
+		const Execution& dst = c.getDestination();
+		const WEIGHT candidate = dist[src.getTaskId()][src.second - 1] + c.getWeight();
+
+		has_output[src.getTaskId()][src.second - 1] = true;
+		relaxed++;
+
+		const bool reached = has_input[dst.getTaskId()][dst.second - 1];
+		WEIGHT& current = dist[dst.getTaskId()][dst.second - 1];
+		if (not reached or current < candidate) {
+			current = candidate;
+			prev[dst.getTaskId()][dst.second - 1] = src;
+			has_input[dst.getTaskId()][dst.second - 1] = true;
+		}
+	}
+
+	/**
+	 * Once every input of tid is relaxed, executions without input are linked to s.
+	 */
+	void close (TASK_ID tid) {
+		for (size_t a = 0 ; a < dist[tid].size() ; a++) {
+			if (not has_input[tid][a]) {
+				dist[tid][a] = 0;
+				prev[tid][a] = Execution(-1, 0);
+				relaxed++;
+			}
+		}
+	}
+
+	/**
+	 * Executions without output are linked to f with the deadline of their task.
+	 */
+	std::pair<Execution, WEIGHT> finish (const ModelAnalysisContext &context) {
+		Execution last = none;
+		WEIGHT length = 0;
+		for (TASK_ID tid : context.getTopologicalOrder()) {
+			const WEIGHT Di = context.getDeadline(tid);
+			for (size_t a = 0 ; a < dist[tid].size() ; a++) {
+				if (has_output[tid][a]) continue;
+				relaxed++;
+				if (last == none or length < dist[tid][a] + Di) {
+					length = dist[tid][a] + Di;
+					last = Execution(tid, a + 1);
+				}
+			}
+		}
+		return std::make_pair(last, length);
+	}
+
+	std::vector<Execution> path (const Execution& last) const {
+		std::vector<Execution> L = {Execution(-1, 1)};
+		Execution e = last;
+		while (e.getTaskId() != -1) {
+			L.push_back(e);
+			e = prev[e.getTaskId()][e.second - 1];
+		}
+		L.push_back(e);
+		std::reverse(L.begin(), L.end());
+		return L;
+	}
+};
+
+
+CriticalPathResult fused_expansion_engine (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+
+	CriticalPathResult res;
+	auto s1 = utils::now();
+
+	const std::vector<TASK_ID>& order = context.getTopologicalOrder();
+
+	FusedRelaxation relaxation (context, K);
+	for (TASK_ID tid : order) {
+		VERBOSE_FUSED("Relax inputs of task " << tid);
+		for (DEPENDENCY_ID did : context.getInputs(tid)) {
+			new_algorithm2(context, K, did, relaxation);
+		}
+		relaxation.close(tid);
+	}
+
+	if (context.getTaskCount()) {
+		auto last = relaxation.finish(context);
+		res.path = relaxation.path(last.first);
+		res.length = last.second;
+	} else {
+		res.path = {Execution(-1, 1)};
+	}
+
+	auto s2 = utils::now();
+
+	res.vertex_count = 2;
+	for (TASK_ID tid : order) res.vertex_count += K[tid];
+	res.edge_count = relaxation.relaxed;
+	res.graph_computation_time = utils::elapsed_ms(s1, s2);
+
+	VERBOSE_FUSED("Longest path " << res.path << " of length " << res.length);
+	return res;
+}
@@ -193,6 +193,19 @@ void GenerateUniformConnections(LETModel& sample, unsigned int m, std::mt19937&
 
 
 
+}
+
+LETModel shift_task_offset (const LETModel &model, TASK_ID tid, TIME_UNIT delta) {
+	VERBOSE_ASSERT((size_t) tid < model.getTaskCount(), "Task not found");
+	LETModel shifted;
+	for (const Task& t : model.tasks()) {
+		const TIME_UNIT r = (t.getId() == tid) ? t.getr() + delta : t.getr();
+		shifted.addTask(r, t.getD(), t.getT());
+	}
+	for (const Dependency& d : model.dependencies()) {
+		shifted.addDependency(d.getFirst(), d.getSecond());
+	}
+	return shifted;
 }
 
 LETModel generate_Automotive_LET (unsigned int n, unsigned int m, size_t seed) {
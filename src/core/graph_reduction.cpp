@@ -0,0 +1,185 @@
+/*
+ * graph_reduction.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <graph_reduction.h>
+#include <age_latency.h>
+#include <algorithm>
+#include <timing.h>
+
+
+/**
+ * Out edges of u going to v, rows are sorted by (destination, weight).
+ */
+static std::pair<size_t, size_t> find_edges (const CompactConstraintGraph& graph, EXECUTION_ID u, EXECUTION_ID v) {
+	size_t first = graph.outBegin(u), last = graph.outEnd(u);
+	while (first < last) {
+		const size_t middle = first + (last - first) / 2;
+		if (graph.getOutDestination(middle) < v) first = middle + 1; else last = middle;
+	}
+	last = first;
+	while (last < graph.outEnd(u) and graph.getOutDestination(last) == v) last++;
+	return std::make_pair(first, last);
+}
+
+ReducedConstraintGraph reduce_constraint_graph (const LETModel &model, const PeriodicityVector &K, const CompactConstraintGraph& graph, const GraphReductionOptions& options) {
+
+	ReducedConstraintGraph res;
+	const size_t V = graph.getVertexCount();
+	std::vector<bool> removed (graph.getConstraintCount(), false);
+
+	// 1) Parallel constraints, only the last (longest) one of a destination is kept.
+	for (EXECUTION_ID u = 0 ; u < V ; u++) {
+		for (size_t e = graph.outBegin(u) ; e + 1 < graph.outEnd(u) ; e++) {
+			if (graph.getOutDestination(e) == graph.getOutDestination(e + 1)) {
+				removed[e] = true;
+				res.parallel_count++;
+			}
+		}
+	}
+
+	// 2) u -> v is dominated by u -> x -> v when w(u,v) <= w(u,x) + w(x,v).
+	//    Each removal keeps every longest distance, so they can be chained.
+	if (options.dominated) {
+		for (EXECUTION_ID x = 2 ; x < V ; x++) {
+			if (graph.getInputCount(x) * graph.getOutputCount(x) > options.max_intermediate_pairs) continue;
+			for (size_t ie = graph.inBegin(x) ; ie < graph.inEnd(x) ; ie++) {
+				const EXECUTION_ID u = graph.getInSource(ie);
+				const auto ux = find_edges(graph, u, x);
+				if (ux.first == ux.second or removed[ux.second - 1]) continue;
+				if (graph.getInWeight(ie) != graph.getOutWeight(ux.second - 1)) continue; // a shorter parallel one
+				const WEIGHT w1 = graph.getInWeight(ie);
+				for (size_t oe = graph.outBegin(x) ; oe < graph.outEnd(x) ; oe++) {
+					if (removed[oe]) continue;
+					const auto uv = find_edges(graph, u, graph.getOutDestination(oe));
+					for (size_t e = uv.first ; e < uv.second ; e++) {
+						if (not removed[e] and graph.getOutWeight(e) <= w1 + graph.getOutWeight(oe)) {
+							removed[e] = true;
+							res.dominated_count++;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 3) Executions with one input and one output are folded into the constraint that goes through them.
+	std::vector<size_t> inputs (V, 0), outputs (V, 0);
+	for (EXECUTION_ID u = 0 ; u < V ; u++) {
+		for (size_t e = graph.outBegin(u) ; e < graph.outEnd(u) ; e++) {
+			if (removed[e]) continue;
+			outputs[u]++;
+			inputs[graph.getOutDestination(e)]++;
+		}
+	}
+	auto is_series = [&] (EXECUTION_ID v) {
+		return options.series and v >= 2 and inputs[v] == 1 and outputs[v] == 1;
+	};
+	auto next_edge = [&] (EXECUTION_ID v) {
+		size_t e = graph.outBegin(v);
+		while (removed[e]) e++;
+		return e;
+	};
+
+	CompactConstraintGraphBuilder builder (model, K);
+	struct Candidate {
+		EXECUTION_ID destination;
+		WEIGHT weight;
+		size_t chain_first, chain_last; // in chain_ids
+	};
+	std::vector<Candidate> candidates;
+	std::vector<EXECUTION_ID> chain_ids;
+	for (EXECUTION_ID u = 0 ; u < V ; u++) {
+		if (is_series(u)) continue;
+		candidates.clear();
+		chain_ids.clear();
+		bool contracted = false;
+		for (size_t e = graph.outBegin(u) ; e < graph.outEnd(u) ; e++) {
+			if (removed[e]) continue;
+			Candidate c = {graph.getOutDestination(e), graph.getOutWeight(e), chain_ids.size(), chain_ids.size()};
+			while (is_series(c.destination)) {
+				chain_ids.push_back(c.destination);
+				const size_t next = next_edge(c.destination);
+				c.weight += graph.getOutWeight(next);
+				c.destination = graph.getOutDestination(next);
+			}
+			c.chain_last = chain_ids.size();
+			contracted = contracted or c.chain_first != c.chain_last;
+			candidates.push_back(c);
+		}
+
+		// Without contraction the row is still sorted by destination. Contractions can end up parallel,
+		// the longest one is kept.
+		if (contracted) {
+			std::sort(candidates.begin(), candidates.end(), [] (const Candidate& l, const Candidate& r) {
+				return std::tie(l.destination, l.weight) < std::tie(r.destination, r.weight);
+			});
+		}
+		for (size_t i = 0 ; i < candidates.size() ; i++) {
+			const Candidate& c = candidates[i];
+			if (i + 1 < candidates.size() and candidates[i + 1].destination == c.destination) {
+				res.parallel_count++;
+				continue;
+			}
+			builder.add(u, c.destination, c.weight);
+			if (c.chain_first != c.chain_last) {
+				res.contracted_count += c.chain_last - c.chain_first;
+				res.chains[ReducedConstraintGraph::key(u, c.destination)].assign(chain_ids.begin() + c.chain_first, chain_ids.begin() + c.chain_last);
+			}
+		}
+	}
+
+	res.graph = builder.build();
+	VERBOSE_REDUCTION("Reduced " << graph.getConstraintCount() << " constraints to " << res.graph.getConstraintCount()
+			<< " (parallel=" << res.parallel_count << " dominated=" << res.dominated_count << " contracted=" << res.contracted_count << ")");
+	return res;
+}
+
+
+std::vector<Execution> ReducedConstraintGraph::expand (const std::vector<Execution>& path) const {
+	std::vector<Execution> L;
+	for (size_t i = 0 ; i < path.size() ; i++) {
+		L.push_back(path[i]);
+		if (i + 1 == path.size()) break;
+		auto it = chains.find(key(graph.getExecutionId(path[i]), graph.getExecutionId(path[i + 1])));
+		if (it == chains.end()) continue;
+		for (EXECUTION_ID id : it->second) L.push_back(graph.getExecution(id));
+	}
+	return L;
+}
+
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  FindLongestPath(const ReducedConstraintGraph& PKG) {
+	auto FLP = FindLongestPath(PKG.graph);
+	return std::make_pair(PKG.expand(FLP.first), FLP.second);
+}
+
+
+AgeLatencyEngineFun reduced_expansion_engine (GenerateCompactExpansionFun fun, const GraphReductionOptions& options) {
+	return [fun, options] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		CriticalPathResult res;
+		const LETModel& model = context.getModel();
+
+		auto s1 = utils::now();
+		const CompactConstraintGraph PKG = fun(context, K);
+		auto s2 = utils::now();
+		const ReducedConstraintGraph reduced = reduce_constraint_graph(model, K, PKG, options);
+		auto s3 = utils::now();
+		auto FLP = FindLongestPath(reduced);
+		auto s4 = utils::now();
+
+		res.path = std::move(FLP.first);
+		res.length = FLP.second;
+		res.vertex_count = PKG.getExecutionCount();
+		res.edge_count = PKG.getConstraintCount();
+		res.reduced = true;
+		res.reduced_vertex_count = reduced.graph.getExecutionCount();
+		res.reduced_edge_count = reduced.graph.getConstraintCount();
+		res.graph_computation_time = utils::elapsed_ms(s1, s2);
+		res.reduction_time         = utils::elapsed_ms(s2, s3);
+		res.path_computation_time  = utils::elapsed_ms(s3, s4);
+		return res;
+	};
+}
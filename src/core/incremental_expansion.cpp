@@ -0,0 +1,177 @@
+/*
+ * incremental_expansion.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <age_latency.h>
+#include <algorithm2.h>
+#include <utils.h>
+#include <timing.h>
+#include <memory>
+#include <mutex>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_INCR(m) VERBOSE_CUSTOM_DEBUG("INCR", m)
+#else
+#define VERBOSE_INCR(m) {}
+#endif
+
+
+/**
+ * Constraints produced by Algorithm 2 for one dependency.
+ */
+struct DependencyConstraints {
+	std::vector<Constraint> constraints;
+	inline void add(const Constraint& c) { constraints.push_back(c); }
+};
+
+
+/**
+ * Task and dependency wise comparison (LETModel::operator== asserts on tasks sharing an id).
+ */
+static bool same_model (const LETModel& a, const LETModel& b) {
+	if (a.getTaskCount() != b.getTaskCount()) return false;
+	if (a.getDependencyCount() != b.getDependencyCount()) return false;
+	for (size_t tid = 0 ; tid < a.getTaskCount() ; tid++) {
+		const Task& ta = a.tasks()[tid];
+		const Task& tb = b.tasks()[tid];
+		if (ta.getr() != tb.getr() or ta.getC() != tb.getC() or ta.getD() != tb.getD() or ta.getT() != tb.getT()) return false;
+	}
+	return a.dependencies() == b.dependencies();
+}
+
+
+class IncrementalExpansion {
+
+	LETModel model;
+	PeriodicityVector K;
+	std::vector<DependencyConstraints> blocks;
+	PartialConstraintGraph graph;
+
+	void reset (const LETModel& new_model) {
+		VERBOSE_INCR("Reset the incremental expansion");
+		model = new_model;
+		K.clear();
+		blocks.assign(model.getDependencyCount(), DependencyConstraints());
+		graph = PartialConstraintGraph();
+	}
+
+	void remove_start_finish (TASK_ID tid) {
+		const Execution s(-1, 0);
+		const Execution f(-1, 1);
+		const auto Di = model.getTaskById(tid).getD();
+		for (auto a = 1; a <= K[tid]; a++) {
+			const Execution t(tid, a);
+			graph.remove(Constraint(s, t, 0));
+			graph.remove(Constraint(t, f, Di));
+		}
+	}
+
+	/**
+	 * Same rule as add_start_finish, restricted to one task.
+	 */
+	void add_start_finish (TASK_ID tid) {
+		const Execution s(-1, 0);
+		const Execution f(-1, 1);
+		const auto Di = model.getTaskById(tid).getD();
+		for (auto a = 1; a <= K[tid]; a++) {
+			const Execution t(tid, a);
+			if (graph.getInputCount(t) == 0) {
+				graph.add(Constraint(s, t, 0));
+			}
+			if (graph.getOutputCount(t) == 0) {
+				graph.add(Constraint(t, f, Di));
+			}
+		}
+	}
+
+public:
+
+	/**
+	 * Bring the graph to newK, return the number of dependencies that were not expanded again.
+	 */
+	size_t update (const ModelAnalysisContext& context, const PeriodicityVector& newK) {
+
+		if (K.empty() or not same_model(model, context.getModel())) {
+			reset(context.getModel());
+		}
+
+		const size_t n = model.getTaskCount();
+		std::vector<bool> changed (n, false);
+		for (size_t tid = 0 ; tid < n ; tid++) {
+			changed[tid] = K.empty() or K[tid] != newK[tid];
+		}
+
+		std::vector<size_t> dirty;
+		std::vector<bool> affected (changed);
+		for (size_t did = 0 ; did < model.getDependencyCount() ; did++) {
+			const Dependency& d = model.dependencies()[did];
+			if (changed[d.getFirst()] or changed[d.getSecond()]) {
+				dirty.push_back(did);
+				affected[d.getFirst()] = true;
+				affected[d.getSecond()] = true;
+			}
+		}
+
+		VERBOSE_INCR("Expand again " << dirty.size() << " dependencies out of " << model.getDependencyCount());
+
+		// 1) Remove the previous start/finish constraints and blocks of what changes.
+		if (not K.empty()) {
+			for (size_t tid = 0 ; tid < n ; tid++) {
+				if (affected[tid]) remove_start_finish(tid);
+			}
+		}
+		for (size_t did : dirty) {
+			for (const Constraint& c : blocks[did].constraints) graph.remove(c);
+			blocks[did].constraints.clear();
+		}
+
+		// 2) Expand them again, duplicated dependencies share constraints so removal is done first.
+		K = newK;
+		for (size_t did : dirty) {
+			new_algorithm2(context, K, did, blocks[did]);
+			for (const Constraint& c : blocks[did].constraints) graph.add(c);
+		}
+
+		// 3) Start and finish constraints of the tasks that may have gained or lost some.
+		for (size_t tid = 0 ; tid < n ; tid++) {
+			if (affected[tid]) add_start_finish(tid);
+		}
+
+		return model.getDependencyCount() - dirty.size();
+	}
+
+	const PartialConstraintGraph& getGraph () const { return graph; }
+};
+
+
+AgeLatencyEngineFun incremental_expansion_engine () {
+
+	auto state = std::make_shared<IncrementalExpansion>();
+	auto mutex = std::make_shared<std::mutex>();
+
+	return [state, mutex] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		// Speculative candidates may come from several threads, they take turns on the one graph.
+		const std::lock_guard<std::mutex> lock (*mutex);
+		CriticalPathResult res;
+
+		auto s1 = utils::now();
+		res.reused_dependencies = state->update(context, K);
+		const PartialConstraintGraph& PKG = state->getGraph();
+		auto s2 = utils::now();
+
+		auto s3 = utils::now();
+		auto FLP = FindLongestPath(PKG);
+		auto s4 = utils::now();
+
+		res.path = std::move(FLP.first);
+		res.length = FLP.second;
+		res.vertex_count = PKG.getExecutions().size();
+		res.edge_count = PKG.getConstraints().size();
+		res.graph_computation_time = utils::elapsed_ms(s1, s2);
+		res.path_computation_time = utils::elapsed_ms(s3, s4);
+		return res;
+	};
+}
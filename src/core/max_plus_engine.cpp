@@ -0,0 +1,209 @@
+/*
+ * max_plus_engine.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <max_plus.h>
+#include <age_latency.h>
+#include <algorithm>
+#include <timing.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define MAX_PLUS_X86
+#endif
+
+
+MaxPlusBlock make_max_plus_block (const Theorem6Kernel& kernel, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj) {
+
+	MaxPlusBlock block;
+	block.Ki = Ki;
+	block.Kj = Kj;
+	const WEIGHT threshold = kernel.rjmripTimTj + kernel.Me - kernel.Ti;
+
+	// Rows are written in place, an empty one is overwritten by the next.
+	block.weights.resize(Ki * Kj);
+	for (EXECUTION_COUNT ai = 1 ; ai <= Ki ; ai++) {
+		WEIGHT* row = block.weights.data() + block.rows.size() * Kj;
+		theorem6_row(kernel, ai, Kj, row);
+
+		EXECUTION_COUNT first = Kj, last = 0;
+		for (EXECUTION_COUNT c = 0 ; c < Kj ; c++) {
+			if (row[c] >= threshold) {
+				first = std::min(first, c);
+				last = c + 1;
+				block.constraint_count++;
+			} else {
+				row[c] = MAX_PLUS_NONE;
+			}
+		}
+		if (last == 0) continue;
+
+		block.rows.push_back(ai);
+		block.first.push_back(first);
+		block.last.push_back(last);
+	}
+	block.weights.resize(block.rows.size() * Kj);
+
+	VERBOSE_MAXPLUS("Block " << Ki << "x" << Kj << " rows=" << block.rows.size() << " constraints=" << block.constraint_count);
+	return block;
+}
+
+
+static void scalar_max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count) {
+	for (size_t k = 0 ; k < count ; k++) {
+		const WEIGHT candidate = distance + weights[k];
+		if (candidate > dist[k]) {
+			dist[k] = candidate;
+			prev[k] = predecessor;
+		}
+	}
+}
+
+#ifdef MAX_PLUS_X86
+
+__attribute__((target("avx2")))
+static void avx2_max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count) {
+	const size_t lanes = 4;
+	const size_t full = (count / lanes) * lanes;
+	const __m256i d = _mm256_set1_epi64x(distance);
+	const __m256i p = _mm256_set1_epi64x(predecessor);
+	for (size_t k = 0 ; k < full ; k += lanes) {
+		const __m256i candidate = _mm256_add_epi64(d, _mm256_loadu_si256((const __m256i*) (weights + k)));
+		const __m256i current   = _mm256_loadu_si256((const __m256i*) (dist + k));
+		const __m256i better    = _mm256_cmpgt_epi64(candidate, current);
+		_mm256_storeu_si256((__m256i*) (dist + k), _mm256_blendv_epi8(current, candidate, better));
+		_mm256_storeu_si256((__m256i*) (prev + k), _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i*) (prev + k)), p, better));
+	}
+	scalar_max_plus_row(weights + full, distance, predecessor, dist + full, prev + full, count - full);
+}
+
+__attribute__((target("avx512f")))
+static void avx512_max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count) {
+	const size_t lanes = 8;
+	const size_t full = (count / lanes) * lanes;
+	const __m512i d = _mm512_set1_epi64(distance);
+	const __m512i p = _mm512_set1_epi64(predecessor);
+	for (size_t k = 0 ; k < full ; k += lanes) {
+		const __m512i candidate = _mm512_add_epi64(d, _mm512_loadu_si512((const void*) (weights + k)));
+		const __m512i current   = _mm512_loadu_si512((const void*) (dist + k));
+		const __mmask8 better   = _mm512_cmpgt_epi64_mask(candidate, current);
+		_mm512_mask_storeu_epi64((void*) (dist + k), better, candidate);
+		_mm512_mask_storeu_epi64((void*) (prev + k), better, p);
+	}
+	scalar_max_plus_row(weights + full, distance, predecessor, dist + full, prev + full, count - full);
+}
+
+#endif
+
+void max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count, RowKernelIsa isa) {
+	switch (isa) {
+#ifdef MAX_PLUS_X86
+	case RowKernelIsa::avx512 : avx512_max_plus_row(weights, distance, predecessor, dist, prev, count); return;
+	case RowKernelIsa::avx2   : avx2_max_plus_row(weights, distance, predecessor, dist, prev, count); return;
+#endif
+	default : scalar_max_plus_row(weights, distance, predecessor, dist, prev, count); return;
+	}
+}
+
+void max_plus_row (const WEIGHT* weights, WEIGHT distance, long predecessor, WEIGHT* dist, long* prev, size_t count) {
+	static const RowKernelIsa isa = detect_row_kernel_isa();
+	max_plus_row(weights, distance, predecessor, dist, prev, count, isa);
+}
+
+
+/**
+ * Columns relaxed together: the distances and predecessors of a tile stay in L1
+ * while every stored row of the block streams through it.
+ */
+static const EXECUTION_COUNT MAX_PLUS_TILE = 256;
+
+/**
+ * One distance vector per task, executions of task t are [offsets[t], offsets[t + 1]).
+ * prev holds the index of the predecessor, -1 for s.
+ */
+CriticalPathResult max_plus_engine (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+
+	CriticalPathResult res;
+	auto s1 = utils::now();
+
+	const size_t n = context.getTaskCount();
+	std::vector<size_t> offsets (n + 1, 0);
+	for (size_t tid = 0 ; tid < n ; tid++) offsets[tid + 1] = offsets[tid] + K[tid];
+
+	std::vector<WEIGHT> dist (offsets[n], MAX_PLUS_NONE);
+	std::vector<long>   prev (offsets[n], -1);
+	std::vector<bool>   has_output (offsets[n], false);
+	size_t relaxed = 0;
+
+	for (TASK_ID tj : context.getTopologicalOrder()) {
+		WEIGHT* dist_j = dist.data() + offsets[tj];
+		long*   prev_j = prev.data() + offsets[tj];
+
+		for (DEPENDENCY_ID did : context.getInputs(tj)) {
+			const TASK_ID ti = context.getDependency(did).ti;
+			const MaxPlusBlock block = make_max_plus_block(context.getKernel(did, K), K[ti], K[tj]);
+			relaxed += block.constraint_count;
+			for (EXECUTION_COUNT ai : block.rows) has_output[offsets[ti] + ai - 1] = true;
+
+			VERBOSE_MAXPLUS("Relax dependency " << did << " from task " << ti << " to task " << tj);
+			for (EXECUTION_COUNT c0 = 0 ; c0 < block.Kj ; c0 += MAX_PLUS_TILE) {
+				const EXECUTION_COUNT c1 = std::min(c0 + MAX_PLUS_TILE, block.Kj);
+				for (size_t r = 0 ; r < block.rows.size() ; r++) {
+					const EXECUTION_COUNT lo = std::max(c0, block.first[r]);
+					const EXECUTION_COUNT hi = std::min(c1, block.last[r]);
+					if (lo >= hi) continue;
+					const long source = offsets[ti] + block.rows[r] - 1;
+					max_plus_row(block.row(r) + lo, dist[source], source, dist_j + lo, prev_j + lo, hi - lo);
+				}
+			}
+		}
+
+		// Executions no constraint reached are linked to s.
+		for (EXECUTION_COUNT a = 0 ; a < K[tj] ; a++) {
+			if (dist_j[a] < MAX_PLUS_UNREACHED) {
+				dist_j[a] = 0;
+				prev_j[a] = -1;
+				relaxed++;
+			}
+		}
+	}
+
+	// Executions without output are linked to f with the deadline of their task.
+	long last = -1;
+	WEIGHT length = 0;
+	for (TASK_ID tid : context.getTopologicalOrder()) {
+		const WEIGHT Di = context.getDeadline(tid);
+		for (size_t e = offsets[tid] ; e < offsets[tid + 1] ; e++) {
+			if (has_output[e]) continue;
+			relaxed++;
+			if (last == -1 or length < dist[e] + Di) {
+				length = dist[e] + Di;
+				last = e;
+			}
+		}
+	}
+
+	auto execution = [&offsets] (long e) {
+		const TASK_ID tid = std::upper_bound(offsets.begin(), offsets.end(), (size_t) e) - offsets.begin() - 1;
+		return Execution(tid, e - offsets[tid] + 1);
+	};
+	res.path = {Execution(-1, 1)};
+	if (last != -1) {
+		for (long e = last ; e != -1 ; e = prev[e]) res.path.push_back(execution(e));
+		res.path.push_back(Execution(-1, 0));
+	}
+	std::reverse(res.path.begin(), res.path.end());
+	res.length = length;
+
+	auto s2 = utils::now();
+
+	res.vertex_count = 2 + offsets[n];
+	res.edge_count = relaxed;
+	res.graph_computation_time = utils::elapsed_ms(s1, s2);
+
+	VERBOSE_MAXPLUS("Longest path " << res.path << " of length " << res.length);
+	return res;
+}
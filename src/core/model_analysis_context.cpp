@@ -0,0 +1,147 @@
+/*
+ * model_analysis_context.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <model_analysis_context.h>
+#include <algorithm>
+#include <timing.h>
+#include <numeric>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_MAC(m) VERBOSE_CUSTOM_DEBUG("MAC", m)
+#else
+#define VERBOSE_MAC(m) {}
+#endif
+
+
+TaskLevels computeTaskLevels (const LETModel& model) {
+
+	const size_t n = model.getTaskCount();
+	std::vector<size_t> remaining (n, 0);
+	std::vector<size_t> level (n, 0);
+	std::vector<std::vector<TASK_ID>> successors (n);
+	for (const Dependency& d : model.dependencies()) {
+		successors[d.getFirst()].push_back(d.getSecond());
+		remaining[d.getSecond()]++;
+	}
+
+	TaskLevels levels;
+	std::vector<TASK_ID> S;
+	for (size_t tid = 0 ; tid < n ; tid++) {
+		if (remaining[tid] == 0) S.push_back(tid);
+	}
+
+	size_t visited = 0;
+	while (S.size()) {
+		const TASK_ID t = S.back();
+		S.pop_back();
+		visited++;
+		if (levels.size() <= level[t]) levels.resize(level[t] + 1);
+		levels[level[t]].push_back(t);
+		for (TASK_ID succ : successors[t]) {
+			level[succ] = std::max(level[succ], level[t] + 1);
+			if (--remaining[succ] == 0) {
+				S.push_back(succ);
+			}
+		}
+	}
+
+	VERBOSE_ASSERT(visited == n, "Task levels require an acyclic task graph");
+	for (auto& tasks : levels) std::sort(tasks.begin(), tasks.end());
+	return levels;
+}
+
+
+std::vector<TASK_ID> computeTaskTopologicalOrder (const LETModel &model) {
+
+	const size_t n = model.getTaskCount();
+	std::vector<size_t> remaining (n, 0);
+	std::vector<std::vector<TASK_ID>> successors (n);
+	for (const Dependency& d : model.dependencies()) {
+		successors[d.getFirst()].push_back(d.getSecond());
+		remaining[d.getSecond()]++;
+	}
+
+	std::vector<TASK_ID> L;
+	L.reserve(n);
+	std::vector<TASK_ID> S;
+	for (size_t tid = n ; tid-- > 0 ; ) {
+		if (remaining[tid] == 0) S.push_back(tid);
+	}
+
+	while (S.size()) {
+		const TASK_ID t = S.back();
+		S.pop_back();
+		L.push_back(t);
+		for (TASK_ID succ : successors[t]) {
+			if (--remaining[succ] == 0) {
+				S.push_back(succ);
+			}
+		}
+	}
+
+	VERBOSE_ASSERT(L.size() == n, "The topological order requires an acyclic task graph");
+	return L;
+}
+
+
+ModelAnalysisContext::ModelAnalysisContext (const LETModel& model) : model(model), hyperperiod(1), sum_n(0) {
+
+	auto s1 = utils::now();
+
+	const size_t n = model.getTaskCount();
+	periods.reserve(n);
+	offsets.reserve(n);
+	deadlines.reserve(n);
+
+	// The hyperperiod is kept on 128 bits, 0 means it does not fit in a long.
+	utils::wide_integer lcm = 1;
+	for (const Task& t : model.tasks()) {
+		VERBOSE_ASSERT(t.getT() > 0, "task.T Cannot be null");
+		periods.push_back(t.getT());
+		offsets.push_back(utils::exact_integer(t.getr()));
+		deadlines.push_back(utils::exact_integer(t.getD()));
+		if (lcm) {
+			lcm = lcm / std::gcd((INTEGER_TIME_UNIT) (lcm % t.getT()), t.getT()) * t.getT();
+			if (lcm > std::numeric_limits<INTEGER_TIME_UNIT>::max()) lcm = 0;
+		}
+	}
+	hyperperiod = (INTEGER_TIME_UNIT) lcm;
+
+	if (hyperperiod) {
+		N.reserve(n);
+		for (INTEGER_TIME_UNIT T : periods) {
+			N.push_back(hyperperiod / T);
+			sum_n += hyperperiod / T;
+		}
+	}
+
+	inputs.resize(n);
+	outputs.resize(n);
+	dependencies.reserve(model.getDependencyCount());
+	for (size_t did = 0 ; did < model.getDependencyCount() ; did++) {
+		const Dependency& d = model.dependencies()[did];
+		dependencies.emplace_back(model.tasks()[d.getFirst()], model.tasks()[d.getSecond()]);
+		outputs[d.getFirst()].push_back(did);
+		inputs[d.getSecond()].push_back(did);
+	}
+
+	auto s2 = utils::now();
+	setup_time = utils::elapsed_ms(s1, s2);
+
+	VERBOSE_MAC("Context of " << n << " tasks, hyperperiod " << hyperperiod << ", sum N " << sum_n << " in " << setup_time << "ms");
+}
+
+
+const std::vector<TASK_ID>& ModelAnalysisContext::getTopologicalOrder () const {
+	std::call_once(order_once, [this] () { order = computeTaskTopologicalOrder(model); });
+	return order;
+}
+
+const TaskLevels& ModelAnalysisContext::getTaskLevels () const {
+	std::call_once(levels_once, [this] () { levels = computeTaskLevels(model); });
+	return levels;
+}
@@ -7,6 +7,7 @@
 
 
 #include <partial_constraint_graph.h>
+#include <integer_arithmetic.h>
 #include <utils.h>
 #include <algorithm>
 #include <numeric>
@@ -22,41 +23,16 @@
 #endif
 
 
-void take_this_ai_aj (const LETModel &model, const PeriodicityVector &K , const Dependency &d, EXECUTION_COUNT ai,  EXECUTION_COUNT aj, PartialConstraintGraph& graph) {
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
-
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
-
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
-	EXECUTION_COUNT Ki = K[ti_id];
-	EXECUTION_COUNT Kj = K[tj_id];
-
-	INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-	auto gcdeK = std::gcd(Ti * Ki, Tj * Kj);
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
-
-
+/**
+ * The take_* helpers receive the constants of the dependency, computed once by algorithm2.
+ */
+void take_this_ai_aj (const Theorem6Kernel& kernel, TASK_ID ti_id, TASK_ID tj_id, EXECUTION_COUNT ai,  EXECUTION_COUNT aj, PartialConstraintGraph& graph) {
 
 
-		// recall: auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
 
-		INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
-		INTEGER_TIME_UNIT pi_min =
-				std::ceil((-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdeK);
 
 		// From Theorem 6 (ECRTS2020)
-		INTEGER_TIME_UNIT Lmax =
-				rj - ri + Ti - Tj - (pi_min * gcdeK + alphae_ai_aj * gcdeT);
+		INTEGER_TIME_UNIT Lmax = kernel.Lmax(kernel.alphagcdT(ai, aj));
 
 		VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
 		Execution ei(ti_id, ai);
@@ -68,42 +44,14 @@ void take_this_ai_aj (const LETModel &model, const PeriodicityVector &K , const
 }
 
 
-void take_this_ai (const LETModel &model, const PeriodicityVector &K , const Dependency &d, EXECUTION_COUNT ai, PartialConstraintGraph& graph) {
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
-
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
-
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
-	EXECUTION_COUNT Ki = K[ti_id];
-	EXECUTION_COUNT Kj = K[tj_id];
-
-	INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-	auto gcdeK = std::gcd(Ti * Ki, Tj * Kj);
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
+void take_this_ai (const Theorem6Kernel& kernel, TASK_ID ti_id, TASK_ID tj_id, EXECUTION_COUNT ai, EXECUTION_COUNT Kj, PartialConstraintGraph& graph) {
 
 
 	for (auto aj = 1; aj <= Kj; aj++) {
 
 
-		// recall: auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
-
-		INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
-		INTEGER_TIME_UNIT pi_min =
-				std::ceil((-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdeK);
-
 		// From Theorem 6 (ECRTS2020)
-		INTEGER_TIME_UNIT Lmax =
-				rj - ri + Ti - Tj - (pi_min * gcdeK + alphae_ai_aj * gcdeT);
+		INTEGER_TIME_UNIT Lmax = kernel.Lmax(kernel.alphagcdT(ai, aj));
 
 		VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
 		Execution ei(ti_id, ai);
@@ -116,41 +64,12 @@ void take_this_ai (const LETModel &model, const PeriodicityVector &K , const Dep
 }
 
 
-void take_this_aj (const LETModel &model, const PeriodicityVector &K , const Dependency &d, EXECUTION_COUNT aj, PartialConstraintGraph& graph) {
-
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
-
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
-
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
-	EXECUTION_COUNT Ki = K[ti_id];
-	EXECUTION_COUNT Kj = K[tj_id];
-
-	INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-	auto gcdeK = std::gcd(Ti * Ki, Tj * Kj);
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
+void take_this_aj (const Theorem6Kernel& kernel, TASK_ID ti_id, TASK_ID tj_id, EXECUTION_COUNT Ki, EXECUTION_COUNT aj, PartialConstraintGraph& graph) {
 
 	for (auto ai = 1; ai <= Ki; ai++) {
 
-		// recall: auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
-
-		INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
-		INTEGER_TIME_UNIT pi_min =
-				std::ceil((-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdeK);
-
 		// From Theorem 6 (ECRTS2020)
-		INTEGER_TIME_UNIT Lmax =
-				rj - ri + Ti - Tj - (pi_min * gcdeK + alphae_ai_aj * gcdeT);
+		INTEGER_TIME_UNIT Lmax = kernel.Lmax(kernel.alphagcdT(ai, aj));
 
 
 		VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
@@ -161,46 +80,17 @@ void take_this_aj (const LETModel &model, const PeriodicityVector &K , const Dep
 
 	}
 }
-void take_them_all (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph) {
-
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
+void take_them_all (const Theorem6Kernel& kernel, TASK_ID ti_id, TASK_ID tj_id, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj, PartialConstraintGraph& graph) {
 
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
-
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
-	EXECUTION_COUNT Ki = K[ti_id];
-	EXECUTION_COUNT Kj = K[tj_id];
-
-	INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-	auto gcdeK = std::gcd(Ti * Ki, Tj * Kj);
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
+	std::vector<INTEGER_TIME_UNIT> row (Kj);
 
 	for (auto ai = 1; ai <= Ki; ai++) {
+		theorem6_row(kernel, ai, Kj, row.data());
 		for (auto aj = 1; aj <= Kj; aj++) {
 
-
-
-			// recall: auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
-
-			INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
-			INTEGER_TIME_UNIT pi_min =
-					std::ceil( (-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdeK );
-
 			// From Theorem 6 (ECRTS2020)
-			INTEGER_TIME_UNIT Lmax =
-					rj - ri + Ti - Tj - (pi_min * gcdeK + alphae_ai_aj * gcdeT);
+			INTEGER_TIME_UNIT Lmax = row[aj - 1];
 
-			VERBOSE_NPCG ("    pi_min=" << pi_min);
 			VERBOSE_NPCG ("    (" <<  ai <<  "," <<  aj <<  ") =" << Lmax);
 
 			Execution ei(ti_id, ai);
@@ -214,7 +104,7 @@ void take_them_all (const LETModel &model, const PeriodicityVector &K , const De
 
 
 
-void algorithm1(const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph, const long x,   const long f0gcdK,  const long g0gcdK,   const long Tx, const long Ty, const long gcdK,  const  long maxY) {
+void algorithm1(const Theorem6Kernel& kernel, TASK_ID ti_id, TASK_ID tj_id, PartialConstraintGraph& graph, const long x,   const long f0gcdK,  const long g0gcdK,   const long Tx, const long Ty, const long gcdK,  const  long maxY) {
 
 	VERBOSE_ALGO1("Start algorithm 1 (x=" << x << ", Tx=" << Tx << ", Ty=" << Ty << ", gcdK=" << gcdK << " maxY=" << maxY << ")");
 
@@ -232,11 +122,11 @@ void algorithm1(const LETModel &model, const PeriodicityVector &K , const Depend
 	//double Tyyg0 = (double) Ty * yg0;
 	//double Tyyf0 = (double) Ty * yf0;
 
-	const double Tyyg0 = (Tx * x - g0gcdK);
-	const double Tyyf0 = (Tx * x - f0gcdK);
+	const long Tyyg0 = (Tx * x - g0gcdK);
+	const long Tyyf0 = (Tx * x - f0gcdK);
 
-	const long start = std::ceil ( Tyyg0 );
-	const long stop  = std::floor ( Tyyf0 );
+	const long start = Tyyg0;
+	const long stop  = Tyyf0;
 
 
 	VERBOSE_ALGO1("Tyyg0=" << Tyyg0);
@@ -267,7 +157,7 @@ void algorithm1(const LETModel &model, const PeriodicityVector &K , const Depend
 
 
 		const long step = (gcdK)/g;
-		const long y0 = u0 - step * std::ceil(u0/step);
+		const long y0 = u0 % step;
 		VERBOSE_ALGO1(" Start subloop from y=" << y0 << " to " << maxY << " with increment of " << gcdK<< "/" <<g << "=" << (gcdK)/g );
 		for (long y = y0 ; y <= maxY ; y += step ) {
 
@@ -278,7 +168,7 @@ void algorithm1(const LETModel &model, const PeriodicityVector &K , const Depend
 
 			if (y > 0 and y <= maxY) {
 				VERBOSE_ALGO1("  Take this ai,aj ( ai=" << x << ", aj=" << y << " ) ");
-				take_this_ai_aj (model, K , d, x, y,  graph);
+				take_this_ai_aj (kernel, ti_id, tj_id, x, y,  graph);
 			}
 		}
 
@@ -314,40 +204,31 @@ void algorithm1(const LETModel &model, const PeriodicityVector &K , const Depend
  *
  */
 
-void algorithm2(const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph ) {
+void algorithm2(const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, PartialConstraintGraph& graph ) {
 
 	VERBOSE_NPCG("Algorithm 2 Starts ");
 
 
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
-
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
-
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
+	TASK_ID ti_id = context.getDependency(did).ti;
+	TASK_ID tj_id = context.getDependency(did).tj;
 
 	EXECUTION_COUNT Ki = K[ti_id];
 	EXECUTION_COUNT Kj = K[tj_id];
 
+	const Theorem6Kernel kernel = context.getKernel(did, K);
+
+	INTEGER_TIME_UNIT Ti = kernel.Ti;
+	INTEGER_TIME_UNIT Tj = kernel.Tj;
+
 
 	EXECUTION_COUNT maxX = Ki;
 	EXECUTION_COUNT maxY = Kj;
 
 
 
-//INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-	auto gcdT = std::gcd(Ti, Tj);
-	auto gcdK = std::gcd(Ti * Ki, Tj * Kj);
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdT) * gcdT;
+	const INTEGER_TIME_UNIT gcdT = kernel.gcdT;
+	const INTEGER_TIME_UNIT gcdK = kernel.gcdK;
+	const INTEGER_TIME_UNIT Me = kernel.Me;
 
 
 	// By definition f00gcdz and g00gcdz are divisible by gcdz
@@ -357,9 +238,6 @@ void algorithm2(const LETModel &model, const PeriodicityVector &K , const Depend
 	EXECUTION_COUNT Tx = Ti;
 	EXECUTION_COUNT Ty = Tj;
 
-	double f0 =  (double) f0gcdk / (double) gcdK;
-	double g0 =  (double) g0gcdk / (double) gcdK;
-
 	VERBOSE_NPCG("Tx=" << Tx << " Ty=" << Ty << "");
 	VERBOSE_NPCG("Ki=" << Ki << " Kj=" << Kj << "");
 	VERBOSE_NPCG("gcdT=" << gcdT << " gcdK=" << gcdK << "");
@@ -369,35 +247,29 @@ void algorithm2(const LETModel &model, const PeriodicityVector &K , const Depend
 
 
 	VERBOSE_NPCG("f0gcdk=" << f0gcdk << " g0gcdk=" << g0gcdk << "");
-	VERBOSE_NPCG("f0=" << f0 << " g0=" << g0 << "");
 
 	//VERBOSE_ASSERT ((f0gcdk % gcdk) == 0, "f0 Must be integer and here f0gcdk=" << f0gcdk << " with gcdk=" << gcdk << " that is (f0gcdk % gcdk)=" << f0gcdk % gcdk);
 	//VERBOSE_ASSERT ((g0gcdk % gcdk) == 0, "g0 Must be integer and here g0gcdk=" << g0gcdk << " with gcdk=" << gcdk << " that is (g0gcdk % gcdk)=" << g0gcdk % gcdk);
-	VERBOSE_ASSERT (f0 <= g0,   "f0 Must be less or equal to g0");
+	VERBOSE_ASSERT (f0gcdk <= g0gcdk,   "f0 Must be less or equal to g0");
 
 
-	// Algorithm 2
-	if (g0 >= 1 + f0) {
+	// Algorithm 2, f0 = f0gcdk / gcdK and g0 = g0gcdk / gcdK
+	if (g0gcdk >= gcdK + f0gcdk) {
 		// Take them all
 		VERBOSE_NPCG (" Case 1 : Take them all");
-		Algorithm2_statistics::getSingleton().total_case1++;
-		take_them_all (model, K , d, graph);
+		LETITGO_INSTRUMENT(InstrumentationCounters::local().algorithm2.total_case1++;)
+		take_them_all (kernel, ti_id, tj_id, Ki, Kj, graph);
 	} else if (Ty == gcdK) {
 
 		VERBOSE_NPCG (" Case 2 : Ty == gcdK");
-		Algorithm2_statistics::getSingleton().total_case2++;
-		VERBOSE_NPCG ("  g0=" << g0 << " f0=" << f0 << " Tx=" << Tx << " gcdK=" << gcdK);
+		LETITGO_INSTRUMENT(InstrumentationCounters::local().algorithm2.total_case2++;)
+		VERBOSE_NPCG ("  g0gcdk=" << g0gcdk << " f0gcdk=" << f0gcdk << " Tx=" << Tx << " gcdK=" << gcdK);
 		for (auto x = 1; x <= maxX ; x++ ) {
 			VERBOSE_NPCG ("  Test x =" << x);
-			double shift = ((double) ( - Tx * x ) /  (double) gcdK);
-
-			double gx0 =  (double) g0 +  (double) shift;
-			double fx0 =  (double) f0 +  (double) shift;
 
-			VERBOSE_NPCG ("   shift = " << shift << " gx0=" << gx0 << " fx0=" << fx0);
-
-			long floorgx0 = (long) std::floor(gx0);
-			long ceilfx0 = (long) std::ceil(fx0);
+			// gx0 = g0 - Tx * x / gcdK and fx0 = f0 - Tx * x / gcdK
+			long floorgx0 = utils::floor_div(g0gcdk - Tx * x, gcdK);
+			long ceilfx0 = utils::ceil_div(f0gcdk - Tx * x, gcdK);
 
 			VERBOSE_NPCG ("   floorgx0=" << floorgx0 << " ceilfx0=" << ceilfx0);
 
@@ -405,7 +277,7 @@ void algorithm2(const LETModel &model, const PeriodicityVector &K , const Depend
 			if (floorgx0 == ceilfx0) {
 				// Take (x,y) for every y
 				VERBOSE_NPCG ("    Take (x,y) for every y");
-				take_this_ai (model, K , d, x, graph);
+				take_this_ai (kernel, ti_id, tj_id, x, Kj, graph);
 			} else {
 				VERBOSE_NPCG ("    Skip it");
 
@@ -414,14 +286,14 @@ void algorithm2(const LETModel &model, const PeriodicityVector &K , const Depend
 	} else {
 
 		VERBOSE_NPCG (" Case 3 : algorithm 1");
-		Algorithm2_statistics::getSingleton().total_case3++;
+		LETITGO_INSTRUMENT(InstrumentationCounters::local().algorithm2.total_case3++;)
 
 		for (EXECUTION_COUNT x = 1; x <= maxX ; x++ ) {
 
 			VERBOSE_NPCG ("  Run algorithm 1 with x =" << x);
 
 			// Algorithm 1
-			algorithm1(model, K , d, graph, x,  f0gcdk,  g0gcdk,  Tx, Ty, gcdK,  maxY);
+			algorithm1(kernel, ti_id, tj_id, graph, x,  f0gcdk,  g0gcdk,  Tx, Ty, gcdK,  maxY);
 
 		}
 
@@ -433,15 +305,16 @@ void algorithm2(const LETModel &model, const PeriodicityVector &K , const Depend
 
 
 PartialConstraintGraph
-new_generate_partial_constraint_graph(const LETModel &model,
+new_generate_partial_constraint_graph(const ModelAnalysisContext &context,
 		const PeriodicityVector &K) {
 
 	PartialConstraintGraph graph;
+	const LETModel& model = context.getModel();
 
 	VERBOSE_NPCG("1) Create constraints.");
-	for (Dependency d : model.dependencies()) {
-		VERBOSE_NPCG(" Run Algorithm 2 for d=" << d);
-		algorithm2(model, K , d, graph) ;
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		VERBOSE_NPCG(" Run Algorithm 2 for d=" << model.dependencies()[did]);
+		algorithm2(context, K , did, graph) ;
 	}
 
 	VERBOSE_NPCG("2) Constraints done, add start and finish.");
@@ -449,3 +322,8 @@ new_generate_partial_constraint_graph(const LETModel &model,
 	return graph;
 }
 
+PartialConstraintGraph new_generate_partial_constraint_graph (const LETModel &model, const PeriodicityVector &K) {
+	const ModelAnalysisContext context (model);
+	return new_generate_partial_constraint_graph(context, K);
+}
+
@@ -0,0 +1,132 @@
+/*
+ * parallel_expansion.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <partial_constraint_graph.h>
+#include <compact_constraint_graph.h>
+#include <algorithm2.h>
+#include <parallel.h>
+#include <utils.h>
+#include <algorithm>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_PAR(m) VERBOSE_CUSTOM_DEBUG("PAR", m)
+#else
+#define VERBOSE_PAR(m) {}
+#endif
+
+
+/**
+ * Rows [first_ai, last_ai] of one dependency, and the constraints they produce.
+ */
+struct ExpansionWorkItem {
+	size_t dependency;
+	EXECUTION_COUNT first_ai;
+	EXECUTION_COUNT last_ai;
+	std::vector<Constraint> constraints;
+	InstrumentationCounters counters;
+
+	ExpansionWorkItem (size_t dependency, EXECUTION_COUNT first_ai, EXECUTION_COUNT last_ai)
+	: dependency(dependency), first_ai(first_ai), last_ai(last_ai) {}
+
+	inline void add(const Constraint& c) { constraints.push_back(c); }
+};
+
+
+/**
+ * One work item per dependency, dependencies with a large Ki*Kj are split by ai ranges
+ * so that the biggest blocks do not end up on a single thread.
+ */
+static std::vector<ExpansionWorkItem> split_expansion (const ModelAnalysisContext &context, const PeriodicityVector &K, size_t thread_count) {
+
+	const size_t min_chunk = 1024;
+
+	size_t total = 0;
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		total += K[context.getDependency(did).ti] * K[context.getDependency(did).tj];
+	}
+	const size_t chunk = std::max(min_chunk, total / (8 * thread_count));
+
+	std::vector<ExpansionWorkItem> items;
+	for (size_t did = 0 ; did < context.getDependencyCount() ; did++) {
+		const EXECUTION_COUNT Ki = K[context.getDependency(did).ti];
+		const EXECUTION_COUNT Kj = K[context.getDependency(did).tj];
+		const EXECUTION_COUNT rows = std::max<EXECUTION_COUNT>(1, chunk / Kj);
+		for (EXECUTION_COUNT first_ai = 1 ; first_ai <= Ki ; first_ai += rows) {
+			items.emplace_back(did, first_ai, std::min(Ki, first_ai + rows - 1));
+		}
+	}
+
+	VERBOSE_PAR("Split " << context.getDependencyCount() << " dependencies into " << items.size() << " work items");
+	return items;
+}
+
+
+/**
+ * Workers fill the buffer of their work items, then the buffers are merged in item order
+ * on the calling thread, so the graph does not depend on the scheduling.
+ */
+template <typename GRAPH>
+static void parallel_expand (const ModelAnalysisContext &context, const PeriodicityVector &K, size_t thread_count, GRAPH& graph) {
+
+	thread_count = utils::resolve_thread_count(thread_count);
+	std::vector<ExpansionWorkItem> items = split_expansion(context, K, thread_count);
+
+	utils::parallel_for(items.size(), thread_count, [&context, &K, &items] (size_t i) {
+		ExpansionWorkItem& item = items[i];
+		// Counters of the item are collected apart, the calling thread also runs items.
+		InstrumentationScope scope;
+		new_algorithm2(context, K, item.dependency, item, item.first_ai, item.last_ai);
+		item.counters = scope.collect();
+		InstrumentationCounters::local().clear();
+	});
+
+	InstrumentationCounters& counters = InstrumentationCounters::local();
+	for (ExpansionWorkItem& item : items) {
+		for (const Constraint& c : item.constraints) graph.add(c);
+		std::vector<Constraint>().swap(item.constraints);
+		counters += item.counters;
+	}
+}
+
+
+PartialConstraintGraph parallel_generate_partial_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K, size_t thread_count) {
+
+	PartialConstraintGraph graph;
+	parallel_expand(context, K, thread_count, graph);
+	add_start_finish (context.getModel(), K, graph);
+	return graph;
+}
+
+PartialConstraintGraph parallel_generate_partial_constraint_graph (const LETModel &model, const PeriodicityVector &K, size_t thread_count) {
+	const ModelAnalysisContext context (model);
+	return parallel_generate_partial_constraint_graph(context, K, thread_count);
+}
+
+CompactConstraintGraph parallel_generate_compact_constraint_graph (const ModelAnalysisContext &context, const PeriodicityVector &K, size_t thread_count) {
+
+	CompactConstraintGraphBuilder builder (context.getModel(), K);
+	parallel_expand(context, K, thread_count, builder);
+	add_start_finish (context.getModel(), K, builder);
+	return builder.build();
+}
+
+CompactConstraintGraph parallel_generate_compact_constraint_graph (const LETModel &model, const PeriodicityVector &K, size_t thread_count) {
+	const ModelAnalysisContext context (model);
+	return parallel_generate_compact_constraint_graph(context, K, thread_count);
+}
+
+GenerateExpansionFun parallel_expansion (size_t thread_count) {
+	return [thread_count] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		return parallel_generate_partial_constraint_graph(context, K, thread_count);
+	};
+}
+
+GenerateCompactExpansionFun parallel_compact_expansion (size_t thread_count) {
+	return [thread_count] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		return parallel_generate_compact_constraint_graph(context, K, thread_count);
+	};
+}
@@ -0,0 +1,87 @@
+/*
+ * parallel_longest_path.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <compact_constraint_graph.h>
+#include <parallel.h>
+#include <algorithm>
+#include <cstdint>
+
+#ifdef ULTRA_DEBUG
+#define VERBOSE_PLP(m) VERBOSE_CUSTOM_DEBUG("PLP", m)
+#else
+#define VERBOSE_PLP(m) {}
+#endif
+
+
+std::pair<std::vector<Execution> , INTEGER_TIME_UNIT>  ParallelFindLongestPath(const CompactConstraintGraph& PKG, const TaskLevels& levels, size_t thread_count) {
+
+	const size_t V = PKG.getVertexCount();
+	const EXECUTION_ID none = std::numeric_limits<EXECUTION_ID>::max();
+	const size_t chunk = 256;
+
+	// One byte per flag, threads write flags of neighbour executions concurrently.
+	std::vector<WEIGHT>       dist (V, 0);
+	std::vector<uint8_t>      reached (V, 0);
+	std::vector<EXECUTION_ID> prev (V, none);
+
+	if (V == 0) {
+		return std::pair<std::vector<Execution>, INTEGER_TIME_UNIT>({Execution(-1, 1)}, 0);
+	}
+
+	reached[CompactConstraintGraph::START] = 1;
+
+	auto pull = [&PKG, &dist, &reached, &prev, none] (EXECUTION_ID v) {
+		EXECUTION_ID best = none;
+		WEIGHT best_dist = 0;
+		for (size_t e = PKG.inBegin(v) ; e < PKG.inEnd(v) ; e++) {
+			const EXECUTION_ID src = PKG.getInSource(e);
+			if (not reached[src]) continue;
+			const WEIGHT candidate = dist[src] + PKG.getInWeight(e);
+			if (best == none or best_dist < candidate or (best_dist == candidate and src < best)) {
+				best = src;
+				best_dist = candidate;
+			}
+		}
+		if (best != none) {
+			dist[v] = best_dist;
+			prev[v] = best;
+			reached[v] = 1;
+		}
+	};
+
+	// Cut the executions of each level into ranges of at most chunk executions.
+	std::vector<std::vector<std::pair<EXECUTION_ID, EXECUTION_ID>>> ranges (levels.size());
+	std::vector<size_t> range_counts (levels.size());
+	for (size_t l = 0 ; l < levels.size() ; l++) {
+		for (TASK_ID t : levels[l]) {
+			for (EXECUTION_ID first = PKG.taskBegin(t) ; first < PKG.taskEnd(t) ; first += chunk) {
+				ranges[l].push_back(std::make_pair(first, std::min<EXECUTION_ID>(PKG.taskEnd(t), first + chunk)));
+			}
+		}
+		range_counts[l] = ranges[l].size();
+		VERBOSE_PLP("Level of " << levels[l].size() << " tasks in " << ranges[l].size() << " ranges");
+	}
+
+	// One parallel region for every level, a level starts once the previous one is done.
+	utils::parallel_for_phases(range_counts, thread_count, [&ranges, &pull] (size_t l, size_t i) {
+		for (EXECUTION_ID v = ranges[l][i].first ; v < ranges[l][i].second ; v++) pull(v);
+	});
+
+	pull(CompactConstraintGraph::FINISH);
+
+	std::vector<Execution> L;
+	EXECUTION_ID e = CompactConstraintGraph::FINISH;
+	while (prev[e] != none) {
+		L.push_back(PKG.getExecution(e));
+		e = prev[e];
+	}
+	L.push_back(PKG.getExecution(e));
+
+	std::reverse(L.begin(), L.end());
+
+	return std::pair<std::vector<Execution>, INTEGER_TIME_UNIT>(L, dist[CompactConstraintGraph::FINISH]);
+}
@@ -6,6 +6,7 @@
  */
 
 #include <partial_constraint_graph.h>
+#include <integer_arithmetic.h>
 #include <utils.h>
 #include <algorithm>
 #include <numeric>
@@ -13,21 +14,27 @@
 
 
 std::pair<std::vector<Execution>, INTEGER_TIME_UNIT>
-FindLongestPath(PartialConstraintGraph PKG) {
+FindLongestPath(const PartialConstraintGraph& PKG) {
 
-	std::map<Execution, WEIGHT> dist;
-	std::map<Execution, Execution> prev;
+	typedef utils::CountingAllocator<std::pair<const Execution, WEIGHT>> DistAllocator;
+	typedef utils::CountingAllocator<std::pair<const Execution, Execution>> PrevAllocator;
+	std::map<Execution, WEIGHT, std::less<Execution>, DistAllocator> dist;
+	std::map<Execution, Execution, std::less<Execution>, PrevAllocator> prev;
 
 	dist[Execution(-1, 0)] = 0;
 
 	std::vector<Execution> ordered_execution = topologicalOrder(PKG);
 
-	for (Execution src : ordered_execution) {
-		if (dist.count(src)) {
-			for (Constraint c : PKG.getOutputs(src)) {
-				Execution dest = c.getDestination();
-				if (dist.count(dest) == 0 || dist[dest] < dist[src] + c.getWeight()) {
-					dist[dest] = dist[src] + c.getWeight();
+	for (const Execution& src : ordered_execution) {
+		auto src_it = dist.find(src);
+		if (src_it != dist.end()) {
+			const WEIGHT src_dist = src_it->second;
+			for (const Constraint& c : PKG.getOutputs(src)) {
+				const Execution& dest = c.getDestination();
+				const WEIGHT candidate = src_dist + c.getWeight();
+				auto const reached = dist.insert(std::make_pair(dest, candidate));
+				if (reached.second || reached.first->second < candidate) {
+					reached.first->second = candidate;
 
 					auto const result = prev.insert(std::make_pair(dest, src));
 					if (not result.second) {
@@ -35,7 +42,6 @@ FindLongestPath(PartialConstraintGraph PKG) {
 					}
 
 					VERBOSE_PCG(" Update " << dest << " by " << src);
-					VERBOSE_PCG(" prev =  " << prev);
 				}
 			}
 		} else {
@@ -43,19 +49,17 @@ FindLongestPath(PartialConstraintGraph PKG) {
 		}
 	}
 
-	for (Execution e : ordered_execution) {
+	for (const Execution& e : ordered_execution) {
 		VERBOSE_ASSERT(dist.count(e), "Could not find dist for execution" << e);
 		VERBOSE_PCG(e << " distance is " << dist[e]);
 	}
 
-	VERBOSE_PCG(prev);
-
 	std::vector<Execution> L;
 	Execution e = Execution(-1, 1);
-	while (prev.count(e) == 1) {
-		VERBOSE_PCG("Longest to " << e << " comes from " << prev.at(e));
+	for (auto it = prev.find(e) ; it != prev.end() ; it = prev.find(e)) {
+		VERBOSE_PCG("Longest to " << e << " comes from " << it->second);
 		L.push_back(e);
-		e = prev.at(e);
+		e = it->second;
 	}
 	L.push_back(e);
 
@@ -67,11 +71,20 @@ FindLongestPath(PartialConstraintGraph PKG) {
 
 
 
-std::vector<Execution> topologicalOrder(PartialConstraintGraph PKG) {
+/**
+ * Kahn's algorithm, edges are not removed from a copy of the graph anymore,
+ * instead a remaining in-degree counter is kept per execution.
+ */
+std::vector<Execution> topologicalOrder(const PartialConstraintGraph& PKG) {
+
+	typedef utils::CountingAllocator<std::pair<const Execution, size_t>> DegreeAllocator;
+	std::map<Execution, size_t, std::less<Execution>, DegreeAllocator> remaining;
+	for (const auto& in : PKG.inbounds) {
+		remaining.emplace_hint(remaining.end(), in.first, in.second.size());
+	}
 
-	std::map<Execution, std::set<Constraint>> outbounds_copy = PKG.outbounds;
-	std::map<Execution, std::set<Constraint>> inbounds_copy = PKG.inbounds;
 	std::vector<Execution> L;
+	L.reserve(PKG.getExecutions().size());
 	std::vector<Execution> S = {Execution(-1, 0)};
 
 	while (S.size()) {
@@ -79,16 +92,12 @@ std::vector<Execution> topologicalOrder(PartialConstraintGraph PKG) {
 		S.pop_back();
 		L.push_back(n);
 
-		for (Constraint e : outbounds_copy[n]) {
-			Execution m = e.getDestination();
+		for (const Constraint& e : PKG.getOutputs(n)) {
 			// remove edge
-			inbounds_copy[m].erase(e);
-
-			if (inbounds_copy[m].size() == 0) {
-				S.push_back(m);
+			if (--remaining[e.getDestination()] == 0) {
+				S.push_back(e.getDestination());
 			}
 		}
-		outbounds_copy[n].clear();
 	}
 
 	// assert all edges gone
@@ -97,30 +106,7 @@ std::vector<Execution> topologicalOrder(PartialConstraintGraph PKG) {
 
 
 
-void add_constraints (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph) {
-
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
-
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
-
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
-
-	EXECUTION_COUNT Ki = K[ti_id];
-	EXECUTION_COUNT Kj = K[tj_id];
-
-	INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-	auto gcdeK = std::gcd(Ti * Ki, Tj * Kj);
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
+static void add_constraints (TASK_ID ti_id, TASK_ID tj_id, const Theorem6Kernel& kernel, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj, PartialConstraintGraph& graph) {
 
 	for (auto ai = 1; ai <= Ki; ai++) {
 		for (auto aj = 1; aj <= Kj; aj++) {
@@ -128,18 +114,16 @@ void add_constraints (const LETModel &model, const PeriodicityVector &K , const
 			VERBOSE_PCG("  "
 					<< "from " << ai << " to " << aj);
 
-			// recall: auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
+			// recall: Me = Tj + ceil((ri - rj + Di) / gcdeT) * gcdeT;
 
-			INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
-			INTEGER_TIME_UNIT pi_min =
-					std::ceil((-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdeK);
-			INTEGER_TIME_UNIT pi_max =
-					std::floor((-Me + Ti - alphae_ai_aj * gcdeT) / gcdeK);
+			INTEGER_TIME_UNIT alphae_ai_ajgcdeT = kernel.alphagcdT(ai, aj);
+			INTEGER_TIME_UNIT pi_min = kernel.pi_min(alphae_ai_ajgcdeT);
+			INTEGER_TIME_UNIT pi_max = kernel.pi_max(alphae_ai_ajgcdeT);
 
 			VERBOSE_PCG("   "
 					<< "alphae_ai_aj= "
-					<< "(" << Ti << "*" << ai << "-" << Tj << "*" << aj
-					<< ") / " << gcdeT << " = " << alphae_ai_aj);
+					<< "(" << kernel.Ti << "*" << ai << "-" << kernel.Tj << "*" << aj
+					<< ") / " << kernel.gcdT << " = " << alphae_ai_ajgcdeT / kernel.gcdT);
 			VERBOSE_PCG("   "
 					<< "pi_min= " << pi_min);
 			VERBOSE_PCG("   "
@@ -148,7 +132,7 @@ void add_constraints (const LETModel &model, const PeriodicityVector &K , const
 			if (pi_min <= pi_max) {
 				// From Theorem 6 (ECRTS2020)
 				INTEGER_TIME_UNIT Lmax =
-						rj - ri + Ti - Tj - (pi_min * gcdeK + alphae_ai_aj * gcdeT);
+						kernel.rjmripTimTj - (pi_min * kernel.gcdK + alphae_ai_ajgcdeT);
 				VERBOSE_PCG("   "
 						<< "Lmax= " << Lmax);
 
@@ -163,11 +147,31 @@ void add_constraints (const LETModel &model, const PeriodicityVector &K , const
 
 
 
+void add_constraints (const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, PartialConstraintGraph& graph) {
+	LETITGO_DEPENDENCY_TIMER(did);
+
+	TASK_ID ti_id = context.getDependency(did).ti;
+	TASK_ID tj_id = context.getDependency(did).tj;
+
+	add_constraints (ti_id, tj_id, context.getKernel(did, K), K[ti_id], K[tj_id], graph);
+}
+
+void add_constraints (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph) {
+
+	TASK_ID ti_id = d.getFirst();
+	TASK_ID tj_id = d.getSecond();
+
+	const Theorem6Kernel kernel (model.getTaskById(ti_id), model.getTaskById(tj_id), K[ti_id], K[tj_id]);
+	add_constraints (ti_id, tj_id, kernel, K[ti_id], K[tj_id], graph);
+}
+
+
+
 void add_start_finish (const LETModel &model, const PeriodicityVector &K, PartialConstraintGraph& graph) {
 	Execution s(-1, 0);
 	Execution f(-1, 1);
 
-	for (Task task : model.tasks()) {
+	for (const Task& task : model.tasks()) {
 		TASK_ID tid = model.getTaskIdByTask(task);
 		auto Di = model.getTaskById(tid).getD();
 
@@ -176,13 +180,13 @@ void add_start_finish (const LETModel &model, const PeriodicityVector &K, Partia
 			Execution t(tid, a);
 
 			// for any t without pred add s-> t with weight 0
-			if (graph.getInputs(t).size() == 0) {
+			if (graph.getInputCount(t) == 0) {
 				Constraint c(s, t, 0);
 				graph.add(c);
 			}
 
 			// for any t without succ add t -> f with weight Di (i the task)
-			if (graph.getOutputs(t).size() == 0) {
+			if (graph.getOutputCount(t) == 0) {
 				Constraint c(t, f, Di);
 				graph.add(c);
 			}
@@ -192,17 +196,23 @@ void add_start_finish (const LETModel &model, const PeriodicityVector &K, Partia
 
 
 PartialConstraintGraph
-generate_partial_constraint_graph(const LETModel &model,	const PeriodicityVector &K) {
+generate_partial_constraint_graph(const ModelAnalysisContext &context,	const PeriodicityVector &K) {
 
 	PartialConstraintGraph graph;
+	const LETModel& model = context.getModel();
 
-	for (Dependency d : model.dependencies()) {
-		VERBOSE_PCG(" " << d);
-		add_constraints (model, K , d, graph);
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		VERBOSE_PCG(" " << model.dependencies()[did]);
+		add_constraints (context, K , did, graph);
 	}
 
 	add_start_finish (model, K, graph) ;
 	return graph;
 }
 
+PartialConstraintGraph generate_partial_constraint_graph (const LETModel &model, const PeriodicityVector &K) {
+	const ModelAnalysisContext context (model);
+	return generate_partial_constraint_graph(context, K);
+}
+
 
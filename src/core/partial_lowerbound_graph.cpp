@@ -6,6 +6,7 @@
  */
 
 #include <partial_constraint_graph.h>
+#include <integer_arithmetic.h>
 #include <utils.h>
 #include <algorithm>
 #include <numeric>
@@ -14,30 +15,13 @@
 #define VERBOSE_LWB(stream) VERBOSE_DEBUG(stream)
 
 
-void add_lowerbounds (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph) {
-
-	TASK_ID ti_id = d.getFirst();
-	TASK_ID tj_id = d.getSecond();
-
-	Task ti = model.getTaskById(ti_id);
-	Task tj = model.getTaskById(tj_id);
-
-	INTEGER_TIME_UNIT Ti = ti.getT();
-	INTEGER_TIME_UNIT Tj = tj.getT();
-	INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
-
-	auto Di = ti.getD();
-	//auto Dj = tj.getD();
+static void add_lowerbounds (TASK_ID ti_id, TASK_ID tj_id, const Theorem6Kernel& kernel, EXECUTION_COUNT Ki, EXECUTION_COUNT Kj, PartialConstraintGraph& graph) {
 
-	auto ri = ti.getr();
-	auto rj = tj.getr();
-
-
-	EXECUTION_COUNT Ki = K[ti_id];
-	EXECUTION_COUNT Kj = K[tj_id];
+	INTEGER_TIME_UNIT Ti = kernel.Ti;
+	INTEGER_TIME_UNIT Tj = kernel.Tj;
 	EXECUTION_COUNT TjKj = Tj * Kj;
-
-	auto gcdK = std::gcd(Ti * Ki, Tj * Kj);
+	const INTEGER_TIME_UNIT gcdeT = kernel.gcdT;
+	const INTEGER_TIME_UNIT gcdK = kernel.gcdK;
 
 
 	EXECUTION_COUNT TjKj_gcdK = TjKj/gcdK;
@@ -50,21 +34,17 @@ void add_lowerbounds (const LETModel &model, const PeriodicityVector &K , const
 			<< " gcdK= " << gcdK
 			<< " TjKj_gcdK= " << TjKj_gcdK);
 
-	auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
-
 	for (auto ai = 1; ai <= Ki; ai++) {
 		for (auto aj = 1; aj <= Kj; aj++) {
 
 			VERBOSE_LWB("  "
 					<< "from " << ai << " to " << aj);
 
-			// recall: auto Me = Tj + std::ceil((ri - rj + Di) / gcdeT) * gcdeT;
+			// recall: Me = Tj + ceil((ri - rj + Di) / gcdeT) * gcdeT;
 
 			INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
-			INTEGER_TIME_UNIT pi_min =
-					std::ceil((-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdK);
-			INTEGER_TIME_UNIT pi_max =
-					std::floor((-Me + Ti - alphae_ai_aj * gcdeT) / gcdK);
+			INTEGER_TIME_UNIT pi_min = kernel.pi_min(alphae_ai_aj * gcdeT);
+			INTEGER_TIME_UNIT pi_max = kernel.pi_max(alphae_ai_aj * gcdeT);
 
 			VERBOSE_LWB("   "
 					<< "alphae_ai_aj= "
@@ -108,7 +88,7 @@ void add_lowerbounds (const LETModel &model, const PeriodicityVector &K , const
 
 				// From Theorem 6 (ECRTS2020)
 				INTEGER_TIME_UNIT Lmax =
-						rj - ri + Ti - Tj - (pi_max * gcdK + alphae_ai_aj * gcdeT);
+						kernel.rjmripTimTj - (pi_max * gcdK + alphae_ai_aj * gcdeT);
 				VERBOSE_LWB("   "
 						<< "Lmax= " << Lmax);
 
@@ -123,18 +103,43 @@ void add_lowerbounds (const LETModel &model, const PeriodicityVector &K , const
 
 
 
+void add_lowerbounds (const ModelAnalysisContext &context, const PeriodicityVector &K , DEPENDENCY_ID did, PartialConstraintGraph& graph) {
+
+	TASK_ID ti_id = context.getDependency(did).ti;
+	TASK_ID tj_id = context.getDependency(did).tj;
+
+	add_lowerbounds (ti_id, tj_id, context.getKernel(did, K), K[ti_id], K[tj_id], graph);
+}
+
+void add_lowerbounds (const LETModel &model, const PeriodicityVector &K , const Dependency &d, PartialConstraintGraph& graph) {
+
+	TASK_ID ti_id = d.getFirst();
+	TASK_ID tj_id = d.getSecond();
+
+	const Theorem6Kernel kernel (model.getTaskById(ti_id), model.getTaskById(tj_id), K[ti_id], K[tj_id]);
+	add_lowerbounds (ti_id, tj_id, kernel, K[ti_id], K[tj_id], graph);
+}
+
+
+
 PartialConstraintGraph
-generate_partial_lowerbound_graph(const LETModel &model,	const PeriodicityVector &K) {
+generate_partial_lowerbound_graph(const ModelAnalysisContext &context,	const PeriodicityVector &K) {
 
 	PartialConstraintGraph graph;
+	const LETModel& model = context.getModel();
 
-	for (Dependency d : model.dependencies()) {
-		VERBOSE_LWB(" " << d);
-		add_lowerbounds (model, K , d, graph);
+	for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+		VERBOSE_LWB(" " << model.dependencies()[did]);
+		add_lowerbounds (context, K , did, graph);
 	}
 
 	add_start_finish (model, K, graph) ;
 	return graph;
 }
 
+PartialConstraintGraph generate_partial_lowerbound_graph (const LETModel &model, const PeriodicityVector &K) {
+	const ModelAnalysisContext context (model);
+	return generate_partial_lowerbound_graph(context, K);
+}
+
 
@@ -0,0 +1,103 @@
+/*
+ * refinement_strategy.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <refinement_strategy.h>
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+/**
+ * lcm of the periods of the tasks of the path, s and f are skipped.
+ */
+static INTEGER_TIME_UNIT path_period (const ModelAnalysisContext& context, const std::vector<Execution>& path) {
+	INTEGER_TIME_UNIT T_P = 1;
+	for (const Execution& e : path) {
+		if (e.first == -1) continue;
+		T_P = std::lcm(T_P, context.getPeriod(e.getTaskId()));
+	}
+	return T_P;
+}
+
+RefinementStrategy critical_path_refinement () {
+	return RefinementStrategy();
+}
+
+RefinementStrategy neighbourhood_refinement () {
+	RefinementStrategy strategy;
+	strategy.refine = [] (const ModelAnalysisContext& context, const PeriodicityVector& K, const std::vector<Execution>& path) {
+		const INTEGER_TIME_UNIT T_P = path_period(context, path);
+		PeriodicityVector next = K;
+		auto raise = [&] (TASK_ID u) {
+			const INTEGER_TIME_UNIT Tu = context.getPeriod(u);
+			next[u] = std::lcm(next[u], (EXECUTION_COUNT) (std::lcm(Tu, T_P) / Tu));
+		};
+		for (const Execution& e : path) {
+			if (e.first == -1) continue;
+			for (DEPENDENCY_ID did : context.getInputs(e.getTaskId()))  raise(context.getDependency(did).ti);
+			for (DEPENDENCY_ID did : context.getOutputs(e.getTaskId())) raise(context.getDependency(did).tj);
+		}
+		return std::vector<PeriodicityVector> {next};
+	};
+	return strategy;
+}
+
+RefinementStrategy small_n_refinement (EXECUTION_COUNT threshold) {
+	RefinementStrategy strategy;
+	strategy.initial = [threshold] (const ModelAnalysisContext& context) {
+		PeriodicityVector K = generate_periodicity_vector(context.getModel());
+		if (context.getHyperperiod() == 0) return K;
+		for (TASK_ID t = 0 ; t < (TASK_ID) K.size() ; t++) {
+			if (context.getN(t) <= threshold) K[t] = context.getN(t);
+		}
+		return K;
+	};
+	strategy.refine = [threshold] (const ModelAnalysisContext& context, const PeriodicityVector& K, const std::vector<Execution>& path) {
+		PeriodicityVector next = K;
+		if (context.getHyperperiod() == 0) return std::vector<PeriodicityVector> {next};
+		for (const Execution& e : path) {
+			if (e.first == -1) continue;
+			if (context.getN(e.getTaskId()) <= threshold) next[e.getTaskId()] = context.getN(e.getTaskId());
+		}
+		return std::vector<PeriodicityVector> {next};
+	};
+	return strategy;
+}
+
+RefinementStrategy seeded_refinement () {
+	RefinementStrategy strategy;
+	strategy.initial = [] (const ModelAnalysisContext& context) {
+		PeriodicityVector K = generate_periodicity_vector(context.getModel());
+		for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+			const DependencyConstants& d = context.getDependency(did);
+			const INTEGER_TIME_UNIT Ti = context.getPeriod(d.ti), Tj = context.getPeriod(d.tj);
+			const INTEGER_TIME_UNIT T = std::lcm(Ti, Tj);
+			K[d.ti] = std::lcm(K[d.ti], (EXECUTION_COUNT) (T / Ti));
+			K[d.tj] = std::lcm(K[d.tj], (EXECUTION_COUNT) (T / Tj));
+		}
+		return K;
+	};
+	return strategy;
+}
+
+RefinementStrategy speculative_refinement (const std::vector<RefinementStrategy>& strategies) {
+	VERBOSE_ASSERT(strategies.size() > 0, "Speculative refinement needs at least one strategy");
+	RefinementStrategy strategy;
+	strategy.initial = strategies.front().initial;
+	strategy.refine = [strategies] (const ModelAnalysisContext& context, const PeriodicityVector& K, const std::vector<Execution>& path) {
+		// Strategies often agree, each distinct candidate is evaluated once.
+		std::set<PeriodicityVector> seen;
+		std::vector<PeriodicityVector> candidates;
+		for (const RefinementStrategy& s : strategies) {
+			const std::vector<PeriodicityVector> proposed = s.refine ? s.refine(context, K, path) : std::vector<PeriodicityVector> {K};
+			for (const PeriodicityVector& c : proposed) {
+				if (seen.insert(c).second) candidates.push_back(c);
+			}
+		}
+		return candidates;
+	};
+	return strategy;
+}
@@ -0,0 +1,126 @@
+/*
+ * row_kernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <integer_arithmetic.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define ROW_KERNEL_X86
+#endif
+
+
+std::ostream& operator<< (std::ostream& stream, const RowKernelIsa& isa) {
+	switch (isa) {
+	case RowKernelIsa::scalar : return stream << "scalar";
+	case RowKernelIsa::avx2   : return stream << "avx2";
+	case RowKernelIsa::avx512 : return stream << "avx512";
+	}
+	return stream;
+}
+
+RowKernelIsa detect_row_kernel_isa () {
+#ifdef ROW_KERNEL_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return RowKernelIsa::avx512;
+	if (__builtin_cpu_supports("avx2")) return RowKernelIsa::avx2;
+#endif
+	return RowKernelIsa::scalar;
+}
+
+
+/**
+ * Everything a row needs: Lmax(aj) = base - v(aj) with v(aj) = pos_mod(x0 - Tj * aj, gcdK).
+ */
+struct RowConstants {
+	INTEGER_TIME_UNIT base;
+	INTEGER_TIME_UNIT x0;
+	INTEGER_TIME_UNIT Tj;
+	INTEGER_TIME_UNIT gcdK;
+
+	RowConstants (const Theorem6Kernel& kernel, EXECUTION_COUNT ai)
+	: base (kernel.rjmripTimTj + kernel.Me - kernel.gcdT),
+	  x0 (kernel.Me - kernel.gcdT + kernel.Ti * ai),
+	  Tj (kernel.Tj), gcdK (kernel.gcdK) {}
+
+	inline INTEGER_TIME_UNIT v (EXECUTION_COUNT aj) const { return utils::pos_mod(x0 - Tj * aj, gcdK); }
+
+	// v(aj + lanes) = v(aj) - step(lanes) modulo gcdK
+	inline INTEGER_TIME_UNIT step (EXECUTION_COUNT lanes) const { return utils::pos_mod(Tj * lanes, gcdK); }
+};
+
+/**
+ * Scalar recurrence from aj = first, also used for the tails of the vector kernels.
+ */
+static void scalar_row (const RowConstants& row, EXECUTION_COUNT first, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax) {
+	if (first > Kj) return;
+	const INTEGER_TIME_UNIT step = row.step(1);
+	INTEGER_TIME_UNIT v = row.v(first);
+	for (EXECUTION_COUNT aj = first ; aj <= Kj ; aj++) {
+		Lmax[aj - 1] = row.base - v;
+		v -= step;
+		if (v < 0) v += row.gcdK;
+	}
+}
+
+#ifdef ROW_KERNEL_X86
+
+__attribute__((target("avx2")))
+static void avx2_row (const RowConstants& row, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax) {
+	const EXECUTION_COUNT lanes = 4;
+	const EXECUTION_COUNT full = (Kj / lanes) * lanes;
+	if (full) {
+		const __m256i base = _mm256_set1_epi64x(row.base);
+		const __m256i step = _mm256_set1_epi64x(row.step(lanes));
+		const __m256i gcdK = _mm256_set1_epi64x(row.gcdK);
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i v = _mm256_set_epi64x(row.v(4), row.v(3), row.v(2), row.v(1));
+		for (EXECUTION_COUNT aj = 1 ; aj <= full ; aj += lanes) {
+			_mm256_storeu_si256((__m256i*) (Lmax + aj - 1), _mm256_sub_epi64(base, v));
+			v = _mm256_sub_epi64(v, step);
+			v = _mm256_add_epi64(v, _mm256_and_si256(_mm256_cmpgt_epi64(zero, v), gcdK));
+		}
+	}
+	scalar_row(row, full + 1, Kj, Lmax);
+}
+
+__attribute__((target("avx512f")))
+static void avx512_row (const RowConstants& row, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax) {
+	const EXECUTION_COUNT lanes = 8;
+	const EXECUTION_COUNT full = (Kj / lanes) * lanes;
+	if (full) {
+		const __m512i base = _mm512_set1_epi64(row.base);
+		const __m512i step = _mm512_set1_epi64(row.step(lanes));
+		const __m512i gcdK = _mm512_set1_epi64(row.gcdK);
+		const __m512i zero = _mm512_setzero_si512();
+		__m512i v = _mm512_set_epi64(row.v(8), row.v(7), row.v(6), row.v(5), row.v(4), row.v(3), row.v(2), row.v(1));
+		for (EXECUTION_COUNT aj = 1 ; aj <= full ; aj += lanes) {
+			_mm512_storeu_si512((void*) (Lmax + aj - 1), _mm512_sub_epi64(base, v));
+			v = _mm512_sub_epi64(v, step);
+			v = _mm512_mask_add_epi64(v, _mm512_cmplt_epi64_mask(v, zero), v, gcdK);
+		}
+	}
+	scalar_row(row, full + 1, Kj, Lmax);
+}
+
+#endif
+
+
+void theorem6_row (const Theorem6Kernel& kernel, EXECUTION_COUNT ai, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax, RowKernelIsa isa) {
+	const RowConstants row (kernel, ai);
+	switch (isa) {
+#ifdef ROW_KERNEL_X86
+	case RowKernelIsa::avx512 : avx512_row(row, Kj, Lmax); return;
+	case RowKernelIsa::avx2   : avx2_row(row, Kj, Lmax); return;
+#endif
+	default : scalar_row(row, 1, Kj, Lmax); return;
+	}
+}
+
+void theorem6_row (const Theorem6Kernel& kernel, EXECUTION_COUNT ai, EXECUTION_COUNT Kj, INTEGER_TIME_UNIT* Lmax) {
+	static const RowKernelIsa isa = detect_row_kernel_isa();
+	theorem6_row(kernel, ai, Kj, Lmax, isa);
+}
@@ -0,0 +1,43 @@
+/*
+ * letitgo_microbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <verbose.h>
+#include <microbench.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(verbose,         0, "Specify the verbosity level (0-10)");
+DEFINE_string(filter,        "", "Only run the kernels whose name contains this string");
+DEFINE_int32(warmup,          2, "Untimed runs before every measure");
+DEFINE_double(target_time,  200, "Calibrate the repetitions of every kernel to last about that many milliseconds");
+DEFINE_int32(min_repetitions, 5, "Minimal timed runs per kernel");
+DEFINE_string(baseline,      "", "Output of a previous run to compare with");
+DEFINE_double(threshold,    0.1, "Relative slowdown of the median flagged against the baseline");
+
+
+
+int main (int argc , char * argv[]) {
+	gflags::SetUsageMessage("LETItGo: LET Analysis tool");
+	gflags::SetVersionString("1.0.0");
+	gflags::ParseCommandLineFlags(&argc, &argv, true);
+	utils::set_verbose_mode(FLAGS_verbose);
+
+	MicrobenchConfiguration config;
+
+	config.filter                  = FLAGS_filter;
+	config.measure.warmup          = FLAGS_warmup;
+	config.measure.target_time     = FLAGS_target_time;
+	config.measure.min_repetitions = FLAGS_min_repetitions;
+	config.baseline                = FLAGS_baseline;
+	config.threshold               = FLAGS_threshold;
+
+	const size_t slowdowns = main_microbench ( config ) ;
+
+
+	gflags::ShutDownCommandLineFlags();
+	return slowdowns ? 1 : 0;
+
+}
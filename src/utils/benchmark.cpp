@@ -6,64 +6,75 @@
  */
 
 #include <benchmark.h>
+#include <benchmark_report.h>
 #include <letitgo.h>
-#include <chrono>
+#include <cmath>
 #include <iomanip>
+#include <sstream>
+
+/**
+ * The measure options of a benchmark, with at least iter_count timed calls.
+ */
+static utils::MeasureOptions with_repetitions (utils::MeasureOptions measure, size_t iter_count) {
+	measure.min_repetitions = std::max(measure.min_repetitions, iter_count);
+	return measure;
+}
 
 /**
  *
- * Run the Age latency multiple time on the same graph for n iterations
- * and return the average.
- *
- * execution time in millisecond
+ * Run the Age latency multiple time on the same graph, at least n times after the warm-up,
+ * and return the per call times in millisecond.
  *
  */
 
-double get_age_latency_execution_time (AgeLatencyFun fun, LETModel sample, size_t n) {
-	double sum_time = 0;
-	for (size_t i = 0 ; i < n; i++) {
-		auto t1 = std::chrono::high_resolution_clock::now();
-		fun(sample, generate_partial_constraint_graph);
-		auto t2 = std::chrono::high_resolution_clock::now();
-		auto duration = t2 - t1;
-		sum_time += duration.count();
-	}
-	return (sum_time / n) / 1000000;
+utils::TimingStatistics get_age_latency_execution_time (const AgeLatencyFun& fun, const LETModel& sample, size_t n, const AgeLatencyOptions& options, const utils::MeasureOptions& measure) {
+	return utils::measure([&fun, &sample, &options] () {
+		fun(sample, generate_partial_constraint_graph, options);
+	}, with_repetitions(measure, n));
 }
 
-ExpansionBenchmarkResult  benchmark_expansion   (GenerateExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed) {
-	double sum_time = 0;
-	long sum_edge = 0;
-	long sum_vertex = 0;
+template <typename GRAPH>
+static ExpansionBenchmarkResult  benchmark_expansion_impl   (ExpansionFun<GRAPH> fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed, size_t jobs, bool pin_workers, const utils::MeasureOptions& measure) {
 
 	Generator& g = Generator::getInstance();
 
 	VERBOSE_DEBUG("Start benchmark with n=" << n << " and " << " m=" << m << " seed=" << seed);
-	INTEGER_TIME_UNIT sum_n = 0 ;
-	Algorithm2_statistics total_stats;
-	total_stats.total_case1 = 0;
-	total_stats.total_case2 = 0;
-	total_stats.total_case3 = 0;
-	for (size_t i = 0 ; i < sample_count ; i ++ ) {
+
+	// Each sample has its own seed and is timed on its worker, statistics are per thread.
+	std::vector<ExpansionSample> samples (sample_count);
+	utils::work_stealing_for(std::vector<double>(sample_count, 1.0), jobs, [&] (size_t i, size_t) {
+		ExpansionSample& current = samples[i];
+		current.seed = seed + i;
 
 		// Prepare problem instance
 		LETModel sample = g.generate(dt, n,m, seed + i);
 		auto K = harmonized_periodicity ?  generate_random_ni_periodicity_vector(sample, seed) : generate_random_periodicity_vector(sample, seed);
-		INTEGER_TIME_UNIT lcm = getLCM<INTEGER_TIME_UNIT>(sample);
-		sum_n += getSumN<INTEGER_TIME_UNIT> (sample);
-		VERBOSE_DEBUG("LCM=" << lcm);
+		const ModelAnalysisContext context (sample);
+		current.sum_n = context.getSumN();
+		VERBOSE_DEBUG("LCM=" << context.getHyperperiod());
 		VERBOSE_DEBUG("K=" << K);
 
 		for (Task t : sample.tasks()) {
 			auto tid = t.getId();
 			VERBOSE_ASSERT(K[tid] , 0);
 		}
-		// Check the instance can be solved and retrieve algo2 stats
+		// Check the instance can be solved and retrieve algo2 stats, the cases do not need the instrumentation counters.
+		for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+			switch (algorithm2_case(context.getKernel(did, K))) {
+				case 1 : current.algo2_stats.total_case1++; break;
+				case 2 : current.algo2_stats.total_case2++; break;
+				default : current.algo2_stats.total_case3++; break;
+			}
+		}
+
+		// The patterns a cache that lives for one expansion would share, counted on a cache of the benchmark.
+		ConstraintPatternCache cache;
+		generate_partial_constraint_graph_with_cache(context, K, cache);
+		current.pattern_stats = cache.getStatistics();
 
-		auto original = generate_partial_constraint_graph(sample, K);
-		Algorithm2_statistics::getSingleton().clear();
-		PartialConstraintGraph res = fun(sample, K);
-		total_stats = total_stats + Algorithm2_statistics::getSingleton();
+		const auto original = generate_partial_constraint_graph(context, K);
+		const GRAPH res = fun(context, K);
+		current.memory = res.memory_footprint();
 
 		if (res != original) {
 			std::cout << "Failed with: "  << std::endl
@@ -79,28 +90,95 @@ ExpansionBenchmarkResult  benchmark_expansion   (GenerateExpansionFun fun, size_
 
 
 		//Get timings and statistics
-		double sub_sum_time = 0;
-		for (size_t i = 0 ; i < iter_count; i++) {
-			auto t1 = std::chrono::high_resolution_clock::now();
-			fun(sample, K);
-			auto t2 = std::chrono::high_resolution_clock::now();
-			auto duration = t2 - t1;
-			sub_sum_time += duration.count();
-		}
-		auto duration =  (sub_sum_time / n);
+		current.timing = utils::measure([&fun, &context, &K] () { fun(context, K); }, with_repetitions(measure, iter_count));
+
+		current.vertex = original.getExecutions().size();
+		current.edge = original.getConstraints().size();
+
+		current.time = current.timing.mean;
+		VERBOSE_DEBUG("    **** duration=" << current.timing);
 
-		sum_vertex += original.getExecutions().size();
-		sum_edge += original.getConstraints().size();
+	}, pin_workers);
 
-		sum_time += duration / 1000000;
-		VERBOSE_DEBUG("    **** duration=" << duration);
+	double sum_time = 0;
+	long sum_edge = 0;
+	long sum_vertex = 0;
+	double sum_memory = 0;
+	INTEGER_TIME_UNIT sum_n = 0 ;
+	Algorithm2_statistics total_stats;
+	PatternCache_statistics pattern_stats;
+	utils::TimingStatistics timing;
+	for (const ExpansionSample& current : samples) {
+		sum_time += current.time;
+		sum_edge += current.edge;
+		sum_vertex += current.vertex;
+		sum_memory += current.memory;
+		sum_n += current.sum_n;
+		total_stats = total_stats + current.algo2_stats;
+		pattern_stats = pattern_stats + current.pattern_stats;
+		timing = timing + current.timing;
+	}
+
+	ExpansionBenchmarkResult res (sample_count,(double) sum_n / (double)sample_count, total_stats, (double)sum_time / (double)sample_count, sum_vertex, sum_edge, sum_memory / (double)sample_count, pattern_stats);
+	res.timing = timing;
+	res.samples = std::move(samples);
+	return res;
+}
+
+ExpansionBenchmarkResult  benchmark_expansion   (GenerateExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed, size_t jobs, bool pin_workers, const utils::MeasureOptions& measure) {
+	return benchmark_expansion_impl<PartialConstraintGraph> (fun, sample_count, iter_count, n, m, dt, harmonized_periodicity, seed, jobs, pin_workers, measure);
+}
+
+ExpansionBenchmarkResult  benchmark_compact_expansion (GenerateCompactExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed, size_t jobs, bool pin_workers, const utils::MeasureOptions& measure) {
+	return benchmark_expansion_impl<CompactConstraintGraph> (fun, sample_count, iter_count, n, m, dt, harmonized_periodicity, seed, jobs, pin_workers, measure);
+}
+
+/**
+ * Wall time in milliseconds per sample of iter_count runs of the sample_count expansions of a row
+ * on the work-stealing pool, the largest sum N first.
+ */
+static double benchmark_compact_expansion_batch (GenerateCompactExpansionFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m,  LETDatasetType dt, bool harmonized_periodicity, size_t seed, size_t thread_count) {
+
+	// Samples and their contexts are prepared outside of the timed region.
+	std::vector<LETModel> samples;
+	std::vector<PeriodicityVector> Ks;
+	for (size_t i = 0 ; i < sample_count ; i ++ ) {
+		samples.push_back(Generator::getInstance().generate(dt, n, m, seed + i));
+		Ks.push_back(harmonized_periodicity ? generate_random_ni_periodicity_vector(samples.back(), seed) : generate_random_periodicity_vector(samples.back(), seed));
+	}
+	std::vector<std::unique_ptr<ModelAnalysisContext>> contexts;
+	std::vector<double> costs;
+	for (const LETModel& sample : samples) {
+		contexts.push_back(std::make_unique<ModelAnalysisContext>(sample));
+		costs.push_back((double) contexts.back()->getSumN());
+	}
+
+	const utils::TimingStatistics timing = utils::measure([&fun, &contexts, &Ks, &costs, thread_count] () {
+		utils::work_stealing_for(costs, thread_count, [&fun, &contexts, &Ks] (size_t i, size_t) {
+			fun(*contexts[i], Ks[i]);
+		});
+	}, with_repetitions(utils::MeasureOptions(), iter_count));
+	return timing.mean / (double) sample_count;
+}
+
+/**
+ * Wall time in milliseconds per sample when the sample_count models of a row are analysed by ComputeAgeLatencyBatch.
+ */
+static double benchmark_age_latency_batch (AgeLatencyFun fun, size_t sample_count, size_t n, size_t m, LETDatasetType dt, size_t seed, size_t thread_count) {
 
+	std::vector<LETModel> samples;
+	for (size_t i = 0 ; i < sample_count ; i ++ ) {
+		samples.push_back(Generator::getInstance().generate(dt, n, m, seed + i));
 	}
 
-	return ExpansionBenchmarkResult(sample_count,(double) sum_n / (double)sample_count, total_stats, (double)sum_time / (double)sample_count, sum_vertex, sum_edge);
+	const utils::TimePoint t1 = utils::now();
+	const std::vector<AgeLatencyResult> results = ComputeAgeLatencyBatch(samples, AgeLatencyOptions::production(), thread_count, fun);
+	const double duration = utils::elapsed_ms(t1);
+	VERBOSE_ASSERT_EQUALS(results.size(), sample_count);
+	return duration / (double) sample_count;
 }
 
-AgeLatencyBenchmarkResult benchmark_age_latency (AgeLatencyFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m, LETDatasetType dt, size_t seed) {
+AgeLatencyBenchmarkResult benchmark_age_latency (AgeLatencyFun fun, size_t sample_count, size_t iter_count, size_t n, size_t m, LETDatasetType dt, size_t seed, size_t jobs, bool pin_workers, const utils::MeasureOptions& measure, const AgeLatencyMeasures& measures) {
 
 	//double sum_time = 0;
 	//double sum_iter = 0;
@@ -108,34 +186,85 @@ AgeLatencyBenchmarkResult benchmark_age_latency (AgeLatencyFun fun, size_t sampl
 
 	GenerateExpansionFun expFun = (GenerateExpansionFun) generate_partial_constraint_graph;
 
-	AgeLatencyBenchmarkResult bench_res (n,m,dt);
-
 	VERBOSE_DEBUG("Start benchmark with n=" << n << " and " << " m=" << m);
-	for (size_t i = 0 ; i < sample_count ; i ++ ) {
+
+	// Each sample has its own seed and is timed on its worker, the sums are done in seed order.
+	std::vector<AgeLatencyBenchmarkResult> samples (sample_count, AgeLatencyBenchmarkResult(n, m, dt));
+	utils::work_stealing_for(std::vector<double>(sample_count, 1.0), jobs, [&] (size_t i, size_t) {
+		AgeLatencyBenchmarkResult& sample_res = samples[i];
 		VERBOSE_INFO ("Run generate with arguments n=" << n << ", m=" << m << ", dt=" << dt << ", seed=" << seed + i);
 		LETModel sample = Generator::getInstance().generate(dt, n , m , seed + i);
-		INTEGER_TIME_UNIT lcm = getLCM<INTEGER_TIME_UNIT>(sample);
-		VERBOSE_DEBUG("LCM=" << lcm);
-		INTEGER_TIME_UNIT sum_n = getSumN<INTEGER_TIME_UNIT> (sample);
+		const ModelAnalysisContext context (sample);
+		VERBOSE_DEBUG("LCM=" << context.getHyperperiod());
+		INTEGER_TIME_UNIT sum_n = context.getSumN();
 
 		VERBOSE_INFO ("Run get_age_latency_execution_time");
-		auto duration = get_age_latency_execution_time (fun, sample, iter_count);
+		auto duration = get_age_latency_execution_time (fun, sample, iter_count, AgeLatencyOptions::production(), measure);
+		sample_res.time_stats = duration;
+		sample_res.time  += duration.mean;
 
 		VERBOSE_INFO ("Run get_age_latency one last time");
-		AgeLatencyResult fun_res = fun(sample, expFun);
+		AgeLatencyOptions bound_options;
+		bound_options.compute_lower_bound = true;
+		AgeLatencyResult fun_res = fun(sample, expFun, bound_options);
 		VERBOSE_DEBUG("AgeLatencyResult = " << fun_res);
-		bench_res.time  += duration;
-		bench_res.iter  += fun_res.expansion_edge_count.size();
-		bench_res.sum_n  += sum_n;
-		bench_res.size  += (double) fun_res.expansion_vertex_count.back() / (double) sum_n;
+
+		if (measures.checked) {
+			auto checked_duration = get_age_latency_execution_time (fun, sample, iter_count, AgeLatencyOptions::checked(), measure);
+			sample_res.checked_stats = checked_duration;
+			sample_res.checked_time  += checked_duration.mean;
+		}
+
+		if (measures.gap) {
+			AgeLatencyOptions gap_options;
+			gap_options.stop_on_bound_gap = true;
+			auto gap_duration = get_age_latency_execution_time (fun, sample, iter_count, gap_options, measure);
+			AgeLatencyResult gap_res = fun(sample, expFun, gap_options);
+			VERBOSE_ASSERT_EQUALS(gap_res.age_latency, fun_res.age_latency);
+			sample_res.gap_stats = gap_duration;
+			sample_res.gap_time  += gap_duration.mean;
+			sample_res.gap_saved_iter  += (double) fun_res.iterations - (double) gap_res.iterations;
+		}
+
+		if (measures.warm_start) {
+			// Perturbation workload: one offset moves, the analysis of the original model is the warm start.
+			VERBOSE_INFO ("Run the warm start on a perturbed model");
+			LETModel perturbed = shift_task_offset(sample, (TASK_ID) ((seed + i) % sample.getTaskCount()), 1);
+			AgeLatencyOptions warm_options;
+			warm_options.warm_start_K = fun_res.periodicity_vector;
+			warm_options.warm_start_path = fun_res.critical_path;
+			auto cold_duration = get_age_latency_execution_time (fun, perturbed, iter_count, AgeLatencyOptions::production(), measure);
+			auto warm_duration = get_age_latency_execution_time (fun, perturbed, iter_count, warm_options, measure);
+			AgeLatencyResult cold_res = fun(perturbed, expFun, AgeLatencyOptions::production());
+			AgeLatencyResult warm_res = fun(perturbed, expFun, warm_options);
+			VERBOSE_ASSERT_EQUALS(warm_res.age_latency, cold_res.age_latency);
+			sample_res.cold_stats = cold_duration;
+			sample_res.warm_stats = warm_duration;
+			sample_res.cold_time  += cold_duration.mean;
+			sample_res.warm_time  += warm_duration.mean;
+			sample_res.warm_saved_iter  += (double) cold_res.iterations - (double) warm_res.iterations;
+		}
+		sample_res.samples.push_back({seed + i, fun_res, duration});
+		sample_res.iter  += fun_res.iterations;
+		sample_res.sum_n  += sum_n;
+		sample_res.size  += (double) fun_res.expansion_vertex_count.back() / (double) sum_n;
 		double bound_error = (double) fun_res.upper_bounds.front() - (double) fun_res.lower_bounds.front();
-		bench_res.bound +=  bound_error / (double) fun_res.age_latency;
-		bench_res.g_ctime += fun_res.graph_computation_time;
-		bench_res.p_ctime += fun_res.path_computation_time;
+		sample_res.bound +=  bound_error / (double) fun_res.age_latency;
+		sample_res.g_ctime += fun_res.graph_computation_time;
+		sample_res.p_ctime += fun_res.path_computation_time;
 
-	}
+	}, pin_workers);
+
+	AgeLatencyBenchmarkResult bench_res (n,m,dt);
+	for (const AgeLatencyBenchmarkResult& sample_res : samples) bench_res += sample_res;
 
 	bench_res.time  /= (double) sample_count;
+	bench_res.checked_time  /= (double) sample_count;
+	bench_res.gap_time  /= (double) sample_count;
+	bench_res.gap_saved_iter  /= (double) sample_count;
+	bench_res.cold_time  /= (double) sample_count;
+	bench_res.warm_time  /= (double) sample_count;
+	bench_res.warm_saved_iter  /= (double) sample_count;
 	bench_res.iter  /= (double) sample_count;
 	bench_res.sum_n  /= (double) sample_count;
 	bench_res.size  /= (double) sample_count;
@@ -143,11 +272,25 @@ AgeLatencyBenchmarkResult benchmark_age_latency (AgeLatencyFun fun, size_t sampl
 	bench_res.g_ctime  /= (double) sample_count;
 	bench_res.p_ctime /= (double) sample_count;
 
+	const double not_measured = std::nan("");
+	if (not measures.checked) bench_res.checked_time = not_measured;
+	if (not measures.gap) bench_res.gap_time = bench_res.gap_saved_iter = not_measured;
+	if (not measures.warm_start) bench_res.cold_time = bench_res.warm_time = bench_res.warm_saved_iter = not_measured;
+
 	return bench_res;
 }
 
 
 
+/**
+ * One comment line with the per call statistics of a measured function, in milliseconds.
+ */
+static void print_timing_statistics (const std::string& name, const utils::TimingStatistics& timing) {
+	std::ostringstream line;
+	line << "#  " << std::setw(10) << name << std::setprecision(4) << std::fixed << "  " << timing;
+	std::cout << line.str() << std::endl;
+}
+
 void main_benchmark_expansion (ExpansionBenchmarkConfiguration config) {
 
 	size_t begin_n = config.begin_n ;
@@ -160,38 +303,66 @@ void main_benchmark_expansion (ExpansionBenchmarkConfiguration config) {
 	size_t total = sample_count * (end_n - begin_n + step_n) / step_n;
 	VERBOSE_INFO("Start benchmark of " << total << " runs.");
 
-	//boost::timer::progress_display show_progress( total );
-	std::cout << "############################################################################################" << std::endl;
-	std::cout << "########## LET it Go Age Expansion Benchmarking                                          ###" << std::endl;
-	std::cout << "############################################################################################" << std::endl;
-	std::cout << "#     begin_n = " << begin_n << "" << std::endl;
-	std::cout << "#     end_n = " << end_n << "" << std::endl;
-	std::cout << "#     step_n = " << step_n << "" << std::endl;
-	std::cout << "#     sample_count = " << sample_count << "" << std::endl;
-	std::cout << "#     iter_count = " << iter_count << "" << std::endl;
-	std::cout << "#     fseed = " << fseed << "" << std::endl;
-	std::cout << "############################################################################################" << std::endl;
-
 	GenerateExpansionFun f_original          = (GenerateExpansionFun) generate_partial_constraint_graph;
 	GenerateExpansionFun f_new               = (GenerateExpansionFun) new_generate_partial_constraint_graph;
 	GenerateExpansionFun f_new_and_optimized = (GenerateExpansionFun) opt_new_generate_partial_constraint_graph;
+	GenerateCompactExpansionFun f_compact    = (GenerateCompactExpansionFun) generate_compact_constraint_graph;
+	GenerateExpansionFun f_parallel          = parallel_expansion(config.thread_count);
+	GenerateCompactExpansionFun f_parallel_compact = parallel_compact_expansion(config.thread_count);
+	GenerateExpansionFun f_cached            = (GenerateExpansionFun) cached_generate_partial_constraint_graph;
+
+	const BenchmarkFormat format = str2format(config.format);
+	BenchmarkReport report (std::cout, format);
+	if (format != BenchmarkFormat::text) {
+		BenchmarkReportFields fields = configuration_fields(config);
+		fields.push_back({"threads", json_number((double) utils::resolve_thread_count(config.thread_count))});
+		report.begin_expansion(fields);
+	} else {
+		//boost::timer::progress_display show_progress( total );
+		std::cout << "############################################################################################" << std::endl;
+		std::cout << "########## LET it Go Age Expansion Benchmarking                                          ###" << std::endl;
+		std::cout << "############################################################################################" << std::endl;
+		std::cout << "#     begin_n = " << begin_n << "" << std::endl;
+		std::cout << "#     end_n = " << end_n << "" << std::endl;
+		std::cout << "#     step_n = " << step_n << "" << std::endl;
+		std::cout << "#     sample_count = " << sample_count << "" << std::endl;
+		std::cout << "#     iter_count = " << iter_count << "" << std::endl;
+		std::cout << "#     fseed = " << fseed << "" << std::endl;
+		std::cout << "#     threads = " << utils::resolve_thread_count(config.thread_count) << "" << std::endl;
+		std::cout << "#     jobs = " << utils::resolve_thread_count(config.jobs) << "" << std::endl;
+		std::cout << "#     pin_workers = " << config.pin_workers << "" << std::endl;
+		std::cout << "#     warmup = " << config.measure.warmup << "" << std::endl;
+		std::cout << "#     target_time = " << config.measure.target_time << "" << std::endl;
+		std::cout << "############################################################################################" << std::endl;
 
-	std::cout
-		<< std::setw(4) << "dt"
-		<< std::setw(4) << "KdN"
-		<< std::setw(5) << "n"
-			<< std::setw(5) << "m"
-			<< std::setw(10) << "lcm"
-			<< std::setw(10) << "V"
-			<< std::setw(10) << "E"
-			<< std::setw(10) << "orig"
-			<< std::setw(10) << "new"
-			<< std::setw(10) << "opt"
-			<< std::setw(7) << "ratio"
-			<< std::setw(7) << "TC1"
-			<< std::setw(7) << "TC2"
-			<< std::setw(7) << "TC3"
-			<< std::endl;
+		std::cout
+			<< std::setw(4) << "dt"
+			<< std::setw(4) << "KdN"
+			<< std::setw(5) << "n"
+				<< std::setw(5) << "m"
+				<< std::setw(10) << "lcm"
+				<< std::setw(10) << "V"
+				<< std::setw(10) << "E"
+				<< std::setw(10) << "orig"
+				<< std::setw(10) << "new"
+				<< std::setw(10) << "opt"
+				<< std::setw(10) << "csr"
+				<< std::setw(10) << "par"
+				<< std::setw(10) << "parcsr"
+				<< std::setw(10) << "batch"
+				<< std::setw(10) << "cache"
+				<< std::setw(10) << "csave"
+				<< std::setw(7) << "hit%"
+				<< std::setw(7) << "ratio"
+				<< std::setw(7) << "spdup"
+				<< std::setw(7) << "TC1"
+				<< std::setw(7) << "TC2"
+				<< std::setw(7) << "TC3"
+				<< std::setw(10) << "setKB"
+				<< std::setw(10) << "csrKB"
+				<< std::setw(10) << "patKB"
+				<< std::endl;
+	}
 
 	for (size_t n = begin_n ; n <= end_n ; n+= step_n) {
 
@@ -204,15 +375,32 @@ void main_benchmark_expansion (ExpansionBenchmarkConfiguration config) {
 			for (bool hpf : {false, true}) {
 				for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt} ) {
 
-					std::cout
-					<< std::setw(4)  << dt
-					<< std::setw(4)  << hpf
-					<< std::setw(5)  << n
-							<< std::setw(5)  << m  << std::flush;
+					if (format == BenchmarkFormat::text) {
+						std::cout
+						<< std::setw(4)  << dt
+						<< std::setw(4)  << hpf
+						<< std::setw(5)  << n
+								<< std::setw(5)  << m  << std::flush;
+					}
 
-				ExpansionBenchmarkResult bench_res1  = benchmark_expansion ( f_original , sample_count, iter_count, n, m,dt,  hpf,  seed) ;
-				ExpansionBenchmarkResult bench_res2  = benchmark_expansion ( f_new , sample_count, iter_count, n, m, dt, hpf,  seed) ;
-				ExpansionBenchmarkResult bench_res3  = benchmark_expansion ( f_new_and_optimized , sample_count, iter_count, n, m,dt,  hpf,  seed) ;
+				ExpansionBenchmarkResult bench_res1  = benchmark_expansion ( f_original , sample_count, iter_count, n, m,dt,  hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				ExpansionBenchmarkResult bench_res2  = benchmark_expansion ( f_new , sample_count, iter_count, n, m, dt, hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				ExpansionBenchmarkResult bench_res3  = benchmark_expansion ( f_new_and_optimized , sample_count, iter_count, n, m,dt,  hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				ExpansionBenchmarkResult bench_res4  = benchmark_compact_expansion ( f_compact , sample_count, iter_count, n, m,dt,  hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				ExpansionBenchmarkResult bench_res5  = benchmark_expansion ( f_parallel , sample_count, iter_count, n, m,dt,  hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				ExpansionBenchmarkResult bench_res6  = benchmark_compact_expansion ( f_parallel_compact , sample_count, iter_count, n, m,dt,  hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				ExpansionBenchmarkResult bench_res7  = benchmark_expansion ( f_cached , sample_count, iter_count, n, m,dt,  hpf,  seed, config.jobs, config.pin_workers, config.measure) ;
+				if (format != BenchmarkFormat::text) {
+					report.add_expansion_row("orig", dt, hpf, n, m, bench_res1);
+					report.add_expansion_row("new", dt, hpf, n, m, bench_res2);
+					report.add_expansion_row("opt", dt, hpf, n, m, bench_res3);
+					report.add_expansion_row("csr", dt, hpf, n, m, bench_res4);
+					report.add_expansion_row("par", dt, hpf, n, m, bench_res5);
+					report.add_expansion_row("parcsr", dt, hpf, n, m, bench_res6);
+					report.add_expansion_row("cache", dt, hpf, n, m, bench_res7);
+					continue;
+				}
+				const double batch_time = benchmark_compact_expansion_batch ( f_compact , sample_count, iter_count, n, m,dt,  hpf,  seed, config.thread_count) ;
 				std::cout
 				<< std::setw(10) << bench_res1.sum_n / (double) bench_res1.sample_count
 						<< std::setw(10) << bench_res1.total_vertex_count / (double) bench_res1.sample_count
@@ -220,11 +408,31 @@ void main_benchmark_expansion (ExpansionBenchmarkConfiguration config) {
 						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res1.average_time
 						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res2.average_time
 						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res3.average_time
+						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res4.average_time
+						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res5.average_time
+						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res6.average_time
+						<< std::setw(10) << std::setprecision(2) << std::fixed << batch_time
+						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res7.average_time
+						<< std::setw(10) << std::setprecision(2) << std::fixed << bench_res3.average_time - bench_res7.average_time
+						<< std::setw(7)  << std::setprecision(1) << std::fixed << 100.0 * bench_res7.pattern_stats.hit_rate()
 						<< std::setw(7)  << std::setprecision(2) << std::fixed << bench_res3.average_time /  bench_res1.average_time
+						<< std::setw(7)  << std::setprecision(2) << std::fixed << bench_res4.average_time /  bench_res6.average_time
 						<< std::setw(7)  << std::setprecision(2) << std::fixed << bench_res2.algo2_stats.total_case1 /  (double) (bench_res2.sample_count * m)
 						<< std::setw(7)  << std::setprecision(2) << std::fixed << bench_res2.algo2_stats.total_case2 /  (double) (bench_res2.sample_count * m)
 						<< std::setw(7)  << std::setprecision(2) << std::fixed << bench_res2.algo2_stats.total_case3 /  (double) (bench_res2.sample_count * m)
+						<< std::setw(10) << std::setprecision(1) << std::fixed << bench_res3.average_memory / 1024.0
+						<< std::setw(10) << std::setprecision(1) << std::fixed << bench_res4.average_memory / 1024.0
+						<< std::setw(10) << std::setprecision(1) << std::fixed << bench_res7.pattern_stats.bytes / 1024.0 / (double) bench_res7.sample_count
 						<< std::endl;
+				if (config.percentiles) {
+					print_timing_statistics("orig", bench_res1.timing);
+					print_timing_statistics("new", bench_res2.timing);
+					print_timing_statistics("opt", bench_res3.timing);
+					print_timing_statistics("csr", bench_res4.timing);
+					print_timing_statistics("par", bench_res5.timing);
+					print_timing_statistics("parcsr", bench_res6.timing);
+					print_timing_statistics("cache", bench_res7.timing);
+				}
 				}
 			}
 
@@ -235,6 +443,295 @@ void main_benchmark_expansion (ExpansionBenchmarkConfiguration config) {
 
 }
 
+/**
+ * Average time in milliseconds of at least iter_count runs of fun, after a warm-up run.
+ */
+static double average_time (const std::function<void()>& fun, size_t iter_count) {
+	return utils::measure(fun, with_repetitions(utils::MeasureOptions(), iter_count)).mean;
+}
+
+void main_benchmark_longest_path (LongestPathBenchmarkConfiguration config) {
+
+	const std::vector<size_t>& thread_counts = config.thread_counts;
+	VERBOSE_ASSERT(thread_counts.size() > 0, "At least one thread count is required");
+
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "########## LET it Go Longest Path Scaling Benchmarking                                   ###" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "#     begin_n = " << config.begin_n << "" << std::endl;
+	std::cout << "#     end_n = " << config.end_n << "" << std::endl;
+	std::cout << "#     step_n = " << config.step_n << "" << std::endl;
+	std::cout << "#     sample_count = " << config.sample_count << "" << std::endl;
+	std::cout << "#     iter_count = " << config.iter_count << "" << std::endl;
+	std::cout << "#     fseed = " << config.seed << "" << std::endl;
+	std::cout << "#     hardware threads = " << utils::hardware_thread_count() << "" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+
+	std::cout
+		<< std::setw(5) << "n"
+		<< std::setw(5) << "m"
+		<< std::setw(10) << "V"
+		<< std::setw(10) << "E"
+		<< std::setw(10) << "seq";
+	for (size_t thread_count : thread_counts) {
+		std::cout << std::setw(10) << ("par" + std::to_string(thread_count));
+	}
+	std::cout << std::setw(8) << "scale" << std::endl;
+
+	for (size_t n = config.begin_n ; n <= config.end_n ; n += config.step_n) {
+
+		const size_t m = (n * (n - 1)) / 4;
+		const size_t seed = config.seed + n;
+
+		double sum_vertex = 0, sum_edge = 0, sum_seq = 0;
+		std::vector<double> sum_par (thread_counts.size(), 0);
+
+		for (size_t i = 0 ; i < config.sample_count ; i ++ ) {
+			const LETModel sample = Generator::getInstance().generate(config.kind, n , m , seed + i);
+			const PeriodicityVector K = generate_random_periodicity_vector(sample, seed + i);
+			const ModelAnalysisContext context (sample);
+			const CompactConstraintGraph graph = generate_compact_constraint_graph(context, K);
+			const TaskLevels& levels = context.getTaskLevels();
+
+			const auto expected = FindLongestPath(graph);
+			for (size_t thread_count : thread_counts) {
+				VERBOSE_ASSERT_EQUALS(ParallelFindLongestPath(graph, levels, thread_count).second, expected.second);
+			}
+
+			sum_vertex += graph.getExecutionCount();
+			sum_edge   += graph.getConstraintCount();
+			sum_seq    += average_time([&graph] () { FindLongestPath(graph); }, config.iter_count);
+			for (size_t t = 0 ; t < thread_counts.size() ; t++) {
+				const size_t thread_count = thread_counts[t];
+				sum_par[t] += average_time([&graph, &levels, thread_count] () { ParallelFindLongestPath(graph, levels, thread_count); }, config.iter_count);
+			}
+		}
+
+		const double samples = (double) config.sample_count;
+		std::cout
+			<< std::setw(5) << n
+			<< std::setw(5) << m
+			<< std::setw(10) << std::setprecision(1) << std::fixed << sum_vertex / samples
+			<< std::setw(10) << std::setprecision(1) << std::fixed << sum_edge / samples
+			<< std::setw(10) << std::setprecision(2) << std::fixed << sum_seq / samples;
+		for (double sum : sum_par) {
+			std::cout << std::setw(10) << std::setprecision(2) << std::fixed << sum / samples;
+		}
+		std::cout << std::setw(8) << std::setprecision(2) << std::fixed << sum_par.front() / sum_par.back() << std::endl;
+	}
+}
+
+/**
+ * Lmax of Theorem 6 as computed before the integer kernel, through double.
+ * Only kept here as the baseline of main_benchmark_lmax_kernel.
+ */
+static INTEGER_TIME_UNIT double_Lmax (const Task& ti, const Task& tj, INTEGER_TIME_UNIT gcdT, INTEGER_TIME_UNIT gcdK, EXECUTION_COUNT ai, EXECUTION_COUNT aj) {
+	const INTEGER_TIME_UNIT Ti = ti.getT();
+	const INTEGER_TIME_UNIT Tj = tj.getT();
+	const auto Me = Tj + std::ceil((ti.getr() - tj.getr() + ti.getD()) / gcdT) * gcdT;
+	const INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdT;
+	const INTEGER_TIME_UNIT pi_min = std::ceil((-Me + gcdT - alphae_ai_aj * gcdT) / gcdK);
+	return tj.getr() - ti.getr() + Ti - Tj - (pi_min * gcdK + alphae_ai_aj * gcdT);
+}
+
+void main_benchmark_lmax_kernel (BenchmarkConfiguration config) {
+
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "########## LET it Go Lmax Kernel Benchmarking                                            ###" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "#     begin_n = " << config.begin_n << "" << std::endl;
+	std::cout << "#     end_n = " << config.end_n << "" << std::endl;
+	std::cout << "#     step_n = " << config.step_n << "" << std::endl;
+	std::cout << "#     sample_count = " << config.sample_count << "" << std::endl;
+	std::cout << "#     iter_count = " << config.iter_count << "" << std::endl;
+	std::cout << "#     fseed = " << config.seed << "" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+
+	std::cout
+		<< std::setw(5) << "n"
+		<< std::setw(5) << "m"
+		<< std::setw(12) << "edges"
+		<< std::setw(10) << "double"
+		<< std::setw(10) << "integer"
+		<< std::setw(8) << "ratio";
+	// Case 1 rows, every instruction set up to the one of this CPU
+	std::vector<RowKernelIsa> isas = {RowKernelIsa::scalar};
+	if (detect_row_kernel_isa() != RowKernelIsa::scalar) isas.push_back(RowKernelIsa::avx2);
+	if (detect_row_kernel_isa() == RowKernelIsa::avx512) isas.push_back(RowKernelIsa::avx512);
+	for (RowKernelIsa isa : isas) {
+		std::stringstream name;
+		name << "row:" << isa;
+		std::cout << std::setw(12) << name.str();
+	}
+	std::cout << std::endl;
+
+	for (size_t n = config.begin_n ; n <= config.end_n ; n += config.step_n) {
+
+		const size_t m = (n * (n - 1)) / 4;
+		const size_t seed = config.seed + n;
+
+		double sum_edges = 0, sum_double = 0, sum_integer = 0;
+		std::vector<double> sum_rows (isas.size(), 0);
+
+		for (size_t i = 0 ; i < config.sample_count ; i ++ ) {
+			const LETModel sample = Generator::getInstance().generate(config.kind, n , m , seed + i);
+			const PeriodicityVector K = generate_random_periodicity_vector(sample, seed + i);
+
+			std::vector<Theorem6Kernel> kernels;
+			for (const Dependency& d : sample.dependencies()) {
+				kernels.emplace_back(sample.getTaskById(d.getFirst()), sample.getTaskById(d.getSecond()), K[d.getFirst()], K[d.getSecond()]);
+			}
+
+			// Both kernels visit every (ai, aj) of every dependency, the checksum keeps the work alive.
+			INTEGER_TIME_UNIT double_checksum = 0, integer_checksum = 0;
+			size_t edges = 0;
+			const double double_time = average_time([&] () {
+				double_checksum = 0;
+				edges = 0;
+				for (size_t did = 0 ; did < kernels.size() ; did++) {
+					const Dependency& d = sample.dependencies()[did];
+					const Task ti = sample.getTaskById(d.getFirst());
+					const Task tj = sample.getTaskById(d.getSecond());
+					for (EXECUTION_COUNT ai = 1 ; ai <= K[d.getFirst()] ; ai++) {
+						for (EXECUTION_COUNT aj = 1 ; aj <= K[d.getSecond()] ; aj++) {
+							double_checksum += double_Lmax(ti, tj, kernels[did].gcdT, kernels[did].gcdK, ai, aj);
+							edges++;
+						}
+					}
+				}
+			}, config.iter_count);
+			const double integer_time = average_time([&] () {
+				integer_checksum = 0;
+				for (size_t did = 0 ; did < kernels.size() ; did++) {
+					const Dependency& d = sample.dependencies()[did];
+					for (EXECUTION_COUNT ai = 1 ; ai <= K[d.getFirst()] ; ai++) {
+						for (EXECUTION_COUNT aj = 1 ; aj <= K[d.getSecond()] ; aj++) {
+							integer_checksum += kernels[did].Lmax(kernels[did].alphagcdT(ai, aj));
+						}
+					}
+				}
+			}, config.iter_count);
+
+			VERBOSE_ASSERT_EQUALS(double_checksum, integer_checksum);
+
+			std::vector<INTEGER_TIME_UNIT> row;
+			for (size_t r = 0 ; r < isas.size() ; r++) {
+				INTEGER_TIME_UNIT row_checksum = 0;
+				sum_rows[r] += average_time([&] () {
+					row_checksum = 0;
+					for (size_t did = 0 ; did < kernels.size() ; did++) {
+						const Dependency& d = sample.dependencies()[did];
+						const EXECUTION_COUNT Kj = K[d.getSecond()];
+						row.resize(Kj);
+						for (EXECUTION_COUNT ai = 1 ; ai <= K[d.getFirst()] ; ai++) {
+							theorem6_row(kernels[did], ai, Kj, row.data(), isas[r]);
+							row_checksum = std::accumulate(row.begin(), row.end(), row_checksum);
+						}
+					}
+				}, config.iter_count);
+				VERBOSE_ASSERT_EQUALS(row_checksum, integer_checksum);
+			}
+			sum_edges   += edges;
+			sum_double  += double_time;
+			sum_integer += integer_time;
+		}
+
+		// Milliseconds per sample to nanoseconds per edge
+		const double ns_double  = sum_edges ? 1e6 * sum_double  / sum_edges : 0;
+		const double ns_integer = sum_edges ? 1e6 * sum_integer / sum_edges : 0;
+		std::cout
+			<< std::setw(5) << n
+			<< std::setw(5) << m
+			<< std::setw(12) << std::setprecision(0) << std::fixed << sum_edges / (double) config.sample_count
+			<< std::setw(10) << std::setprecision(2) << std::fixed << ns_double
+			<< std::setw(10) << std::setprecision(2) << std::fixed << ns_integer
+			<< std::setw(8)  << std::setprecision(2) << std::fixed << (ns_integer ? ns_double / ns_integer : 0);
+		for (double sum_row : sum_rows) {
+			std::cout << std::setw(12) << std::setprecision(2) << std::fixed << (sum_edges ? 1e6 * sum_row / sum_edges : 0);
+		}
+		std::cout << std::endl;
+	}
+}
+
+void main_benchmark_block_replication (BlockReplicationBenchmarkConfiguration config) {
+
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "########## LET it Go Block Replication Benchmarking                                      ###" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "#     begin_n = " << config.begin_n << "" << std::endl;
+	std::cout << "#     end_n = " << config.end_n << "" << std::endl;
+	std::cout << "#     step_n = " << config.step_n << "" << std::endl;
+	std::cout << "#     sample_count = " << config.sample_count << "" << std::endl;
+	std::cout << "#     iter_count = " << config.iter_count << "" << std::endl;
+	std::cout << "#     fseed = " << config.seed << "" << std::endl;
+	std::cout << "#     k_divisor = " << config.k_divisor << "" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+
+	std::cout
+		<< std::setw(5) << "n"
+		<< std::setw(5) << "m"
+		<< std::setw(10) << "sumK"
+		<< std::setw(12) << "E"
+		<< std::setw(8) << "blk%"
+		<< std::setw(10) << "opt"
+		<< std::setw(10) << "compact"
+		<< std::setw(10) << "block"
+		<< std::setw(8) << "opt/b"
+		<< std::setw(8) << "cmp/b"
+		<< std::endl;
+
+	for (size_t n = config.begin_n ; n <= config.end_n ; n += config.step_n) {
+
+		const size_t m = (n * (n - 1)) / 4;
+		const size_t seed = config.seed + n;
+
+		double sum_k = 0, sum_edges = 0, sum_pairs = 0, sum_block_pairs = 0;
+		double sum_opt = 0, sum_compact = 0, sum_block = 0;
+
+		for (size_t i = 0 ; i < config.sample_count ; i++) {
+			const LETModel sample = Generator::getInstance().generate(config.kind, n , m , seed + i);
+			const ModelAnalysisContext context (sample);
+
+			// Large K: N, or N divided by what it shares with k_divisor.
+			PeriodicityVector K (sample.getTaskCount());
+			for (const Task& t : sample.tasks()) {
+				const EXECUTION_COUNT N = context.getN(t.getId());
+				K[t.getId()] = N / std::gcd(N, (EXECUTION_COUNT) config.k_divisor);
+				sum_k += K[t.getId()];
+			}
+
+			for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+				const DependencyConstants& d = context.getDependency(did);
+				const ConstraintBlock block (context.getKernel(did, K));
+				sum_pairs       += (double) K[d.ti] * (double) K[d.tj];
+				sum_block_pairs += (double) block.size();
+			}
+
+			const CompactConstraintGraph res = block_generate_compact_constraint_graph(context, K);
+			VERBOSE_ASSERT(res == generate_compact_constraint_graph(context, K), "Block replication must match the compact expansion");
+			sum_edges += res.getConstraintCount();
+
+			sum_opt     += average_time([&] () { opt_new_generate_partial_constraint_graph(context, K); }, config.iter_count);
+			sum_compact += average_time([&] () { generate_compact_constraint_graph(context, K); }, config.iter_count);
+			sum_block   += average_time([&] () { block_generate_compact_constraint_graph(context, K); }, config.iter_count);
+		}
+
+		const double samples = (double) config.sample_count;
+		std::cout
+			<< std::setw(5) << n
+			<< std::setw(5) << m
+			<< std::setw(10) << std::setprecision(0) << std::fixed << sum_k / samples
+			<< std::setw(12) << std::setprecision(0) << std::fixed << sum_edges / samples
+			<< std::setw(8)  << std::setprecision(2) << std::fixed << (sum_pairs ? 100.0 * sum_block_pairs / sum_pairs : 0)
+			<< std::setw(10) << std::setprecision(2) << std::fixed << sum_opt / samples
+			<< std::setw(10) << std::setprecision(2) << std::fixed << sum_compact / samples
+			<< std::setw(10) << std::setprecision(2) << std::fixed << sum_block / samples
+			<< std::setw(8)  << std::setprecision(2) << std::fixed << (sum_block ? sum_opt / sum_block : 0)
+			<< std::setw(8)  << std::setprecision(2) << std::fixed << (sum_block ? sum_compact / sum_block : 0)
+			<< std::endl;
+	}
+}
+
 inline void print_detailed_al_header() {
 	std::cout
 			       << "kind"
@@ -249,12 +746,14 @@ inline void print_detailed_al_header() {
 			<< ";" << "UpperBounds"
 			<< ";" << "gen_time"
 			<< ";" << "sp_time"
+			<< ";" << "Allocations"
+			<< ";" << "ReusedDependencies"
 			<< std::endl;
 }
 
 
 inline void print_detailed_al_row( LETDatasetType dt,
-		  AgeLatencyResult res) {
+		  const AgeLatencyResult& res) {
 
 		/*std::cout
 			  << std::setw(5) << dt
@@ -264,7 +763,14 @@ inline void print_detailed_al_row( LETDatasetType dt,
 				  << std::flush;
 				  std::cout
 				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.checked_time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.gap_time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.time - bench.gap_time
 				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.iter
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.gap_saved_iter
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.cold_time - bench.warm_time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.warm_saved_iter
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.batch_time
 				  << std::setw(10) << bench.size
 				  << std::setw(10) << bench.bound
 				  << std::setw(10) << bench.g_ctime
@@ -277,13 +783,15 @@ inline void print_detailed_al_row( LETDatasetType dt,
 				  << ";"  << res.m
 				  << ";"  << res.sum_n;
 		std::cout << ";"  << std::fixed << res.age_latency;
-		std::cout << ";"  << res.expansion_vertex_count.size()   ;
+		std::cout << ";"  << res.iterations   ;
 		std::cout << ";"  << "\"" << res.expansion_vertex_count << "\""   ;
 		std::cout << ";"  << "\"" << res.expansion_edge_count << "\""   ;
 		std::cout << ";"  << "\"" << res.lower_bounds  << "\""  ;
 		std::cout << ";"  << "\"" << res.upper_bounds << "\""   ;
 		std::cout << ";"  << std::setprecision(2) << std::fixed << res.graph_computation_time  ;
 		std::cout << ";"  << std::setprecision(2) << std::fixed << res.path_computation_time  ;
+		std::cout << ";"  << "\"" << res.allocation_count << "\""   ;
+		std::cout << ";"  << "\"" << res.reused_dependency_count << "\""   ;
 		std::cout << std::endl;
 
 
@@ -296,7 +804,14 @@ inline void print_al_header() {
 			<< std::setw(5) << "m"
 			<< std::setw(10) << "sumN"
 			<< std::setw(10) << "time"
+			<< std::setw(10) << "chktime"
+			<< std::setw(10) << "gaptime"
+			<< std::setw(10) << "gapsaved"
 			<< std::setw(10) << "iter"
+			<< std::setw(10) << "gapiter"
+			<< std::setw(10) << "warmsaved"
+			<< std::setw(10) << "warmiter"
+			<< std::setw(10) << "batch"
 			<< std::setw(10) << "size"
 			<< std::setw(10) << "bound"
 			<< std::setw(10) << "gen_time"
@@ -304,7 +819,7 @@ inline void print_al_header() {
 			<< std::endl;
 }
 
-inline void print_al_row(AgeLatencyBenchmarkResult bench) {
+inline void print_al_row(const AgeLatencyBenchmarkResult& bench) {
 		std::cout
 			  << std::setw(5) << bench.dt
 			  << std::setw(5) << bench.n
@@ -312,7 +827,14 @@ inline void print_al_row(AgeLatencyBenchmarkResult bench) {
 		std::cout
 				  << std::setw(10) << std::fixed << std::setprecision(1)  << bench.sum_n
 				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.checked_time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.gap_time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.time - bench.gap_time
 				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.iter
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.gap_saved_iter
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.cold_time - bench.warm_time
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.warm_saved_iter
+				  << std::setw(10) << std::setprecision(2)  << std::fixed << bench.batch_time
 				  << std::setw(10) << bench.size
 				  << std::setw(10) << bench.bound
 				  << std::setw(10) << bench.g_ctime
@@ -333,13 +855,64 @@ void main_benchmark_age_latency (AgeLantencyBenchmarkConfiguration config) {
 	size_t fseed         = config.seed       ;
 	LETDatasetType       dt = config.kind;
 	AgeLatencyFun original = (AgeLatencyFun) ComputeAgeLatency;
+	if (config.engine == "fused") {
+		original = [] (const LETModel &model, GenerateExpansionFun, const AgeLatencyOptions& options) {
+			return ComputeAgeLatencyWithEngine(model, fused_expansion_engine, options);
+		};
+	} else if (config.engine == "maxplus") {
+		original = [] (const LETModel &model, GenerateExpansionFun, const AgeLatencyOptions& options) {
+			return ComputeAgeLatencyWithEngine(model, max_plus_engine, options);
+		};
+	} else if (config.engine == "reduced") {
+		original = [] (const LETModel &model, GenerateExpansionFun, const AgeLatencyOptions& options) {
+			return ComputeAgeLatencyWithEngine(model, reduced_expansion_engine(), options);
+		};
+	} else if (config.engine == "incremental") {
+		original = [] (const LETModel &model, GenerateExpansionFun, const AgeLatencyOptions& options) {
+			return ComputeAgeLatencyWithEngine(model, incremental_expansion_engine(), options);
+		};
+	} else {
+		VERBOSE_ASSERT(config.engine == "expansion", "Unsupported engine " << config.engine);
+	}
+
+	RefinementStrategy strategy = critical_path_refinement();
+	if (config.refinement == "neighbourhood") {
+		strategy = neighbourhood_refinement();
+	} else if (config.refinement == "small_n") {
+		strategy = small_n_refinement();
+	} else if (config.refinement == "seeded") {
+		strategy = seeded_refinement();
+	} else if (config.refinement == "speculative") {
+		strategy = speculative_refinement({critical_path_refinement(), neighbourhood_refinement(), small_n_refinement()});
+	} else {
+		VERBOSE_ASSERT(config.refinement == "path", "Unsupported refinement " << config.refinement);
+	}
+	const size_t speculative_threads = utils::resolve_thread_count(config.speculative_threads);
+	original = [original, strategy, speculative_threads] (const LETModel &model, GenerateExpansionFun fun, const AgeLatencyOptions& options) {
+		AgeLatencyOptions refined = options;
+		refined.refinement = strategy;
+		refined.speculative_threads = speculative_threads;
+		return original(model, fun, refined);
+	};
 
 
 	size_t total = sample_count * (end_n - begin_n + step_n) / step_n;
 	VERBOSE_INFO("Start benchmark of " << total << " runs.");
 
-
-	if (config.detailed) {
+	BenchmarkReport report (std::cout, str2format(config.format));
+	if (str2format(config.format) != BenchmarkFormat::text) {
+		BenchmarkReportFields fields = configuration_fields(config);
+		fields.push_back({"kind", json_number(dt)});
+		fields.push_back({"engine", json_string(config.engine)});
+		fields.push_back({"refinement", json_string(config.refinement)});
+		fields.push_back({"speculative_threads", json_number((double) speculative_threads)});
+		fields.push_back({"batch_threads", json_number((double) utils::resolve_thread_count(config.batch_threads))});
+		fields.push_back({"measure_checked", config.measures.checked ? "true" : "false"});
+		fields.push_back({"measure_gap", config.measures.gap ? "true" : "false"});
+		fields.push_back({"measure_warm_start", config.measures.warm_start ? "true" : "false"});
+		fields.push_back({"measure_batch", config.measure_batch ? "true" : "false"});
+		report.begin_age_latency(fields);
+	} else if (config.detailed) {
 		print_detailed_al_header();
 	} else {
 		//boost::timer::progress_display show_progress( total );
@@ -352,6 +925,18 @@ void main_benchmark_age_latency (AgeLantencyBenchmarkConfiguration config) {
 		std::cout << "#     sample_count = " << sample_count << "" << std::endl;
 		std::cout << "#     iter_count = " << iter_count << "" << std::endl;
 		std::cout << "#     fseed = " << fseed << "" << std::endl;
+		std::cout << "#     engine = " << config.engine << "" << std::endl;
+		std::cout << "#     refinement = " << config.refinement << "" << std::endl;
+		std::cout << "#     speculative_threads = " << speculative_threads << "" << std::endl;
+		std::cout << "#     batch_threads = " << utils::resolve_thread_count(config.batch_threads) << "" << std::endl;
+		std::cout << "#     measure_checked = " << config.measures.checked << "" << std::endl;
+		std::cout << "#     measure_gap = " << config.measures.gap << "" << std::endl;
+		std::cout << "#     measure_warm_start = " << config.measures.warm_start << "" << std::endl;
+		std::cout << "#     measure_batch = " << config.measure_batch << "" << std::endl;
+		std::cout << "#     jobs = " << utils::resolve_thread_count(config.jobs) << "" << std::endl;
+		std::cout << "#     pin_workers = " << config.pin_workers << "" << std::endl;
+		std::cout << "#     warmup = " << config.measure.warmup << "" << std::endl;
+		std::cout << "#     target_time = " << config.measure.target_time << "" << std::endl;
 		std::cout << "#######################################################################################################################################" << std::endl;
 
 		print_al_header();
@@ -369,16 +954,30 @@ void main_benchmark_age_latency (AgeLantencyBenchmarkConfiguration config) {
 
 				VERBOSE_INFO ("Run benchmark_age_latency with arguments " << sample_count << "," << iter_count << "," << n << "," << m << "," << dt << "," << seed );
 
-				if (config.detailed) {
+				if (config.detailed and str2format(config.format) == BenchmarkFormat::text) {
 					for (size_t i = 0 ; i < sample_count ; i ++ ) {
 						GenerateExpansionFun expFun = (GenerateExpansionFun) generate_partial_constraint_graph;
 						LETModel sample = Generator::getInstance().generate(dt, n , m , seed + i);
-						AgeLatencyResult fun_res = original(sample, expFun);
+						AgeLatencyResult fun_res = original(sample, expFun, AgeLatencyOptions::checked());
 						print_detailed_al_row(dt,fun_res);
 					}
 				} else {
-					AgeLatencyBenchmarkResult bench  = benchmark_age_latency ( original, sample_count, iter_count, n, m, dt, seed) ;
+					AgeLatencyBenchmarkResult bench  = benchmark_age_latency ( original, sample_count, iter_count, n, m, dt, seed, config.jobs, config.pin_workers, config.measure, config.measures) ;
+					bench.batch_time = config.measure_batch ? benchmark_age_latency_batch ( original, sample_count, n, m, dt, seed, config.batch_threads) : std::nan("");
+					if (str2format(config.format) != BenchmarkFormat::text) {
+						report.add_age_latency_row(bench);
+						continue;
+					}
 					print_al_row(bench);
+					if (config.percentiles) {
+						print_timing_statistics("time", bench.time_stats);
+						if (config.measures.checked) print_timing_statistics("checked", bench.checked_stats);
+						if (config.measures.gap) print_timing_statistics("gaptime", bench.gap_stats);
+						if (config.measures.warm_start) {
+							print_timing_statistics("cold", bench.cold_stats);
+							print_timing_statistics("warm", bench.warm_stats);
+						}
+					}
 				}
 			}
 		}
@@ -0,0 +1,285 @@
+/*
+ * benchmark_report.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <benchmark_report.h>
+#include <parallel.h>
+#include <verbose.h>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__unix__)
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+#ifndef LETITGO_GIT_REVISION
+#define LETITGO_GIT_REVISION "unknown"
+#endif
+
+BenchmarkFormat str2format (const std::string& str) {
+	if (str == "text") return BenchmarkFormat::text;
+	if (str == "json") return BenchmarkFormat::json;
+	if (str == "csv") return BenchmarkFormat::csv;
+	VERBOSE_ASSERT(false, "Unknown benchmark format " << str << ", expected text, json or csv");
+	return BenchmarkFormat::text;
+}
+
+BenchmarkEnvironment BenchmarkEnvironment::current () {
+	BenchmarkEnvironment env;
+	env.git_revision = LETITGO_GIT_REVISION;
+	env.host = "unknown";
+	env.system = "unknown";
+#if defined(__unix__)
+	char host[256] = {0};
+	if (gethostname(host, sizeof(host) - 1) == 0) env.host = host;
+	struct utsname name;
+	if (uname(&name) == 0) env.system = std::string(name.sysname) + " " + name.release + " " + name.machine;
+#endif
+#if defined(__VERSION__)
+	env.compiler = __VERSION__;
+#else
+	env.compiler = "unknown";
+#endif
+	env.hardware_threads = utils::hardware_thread_count();
+	return env;
+}
+
+std::string json_string (const std::string& str) {
+	std::ostringstream out;
+	out << '"';
+	for (char c : str) {
+		switch (c) {
+			case '"'  : out << "\\\""; break;
+			case '\\' : out << "\\\\"; break;
+			case '\n' : out << "\\n"; break;
+			case '\t' : out << "\\t"; break;
+			default :
+				if ((unsigned char) c < 0x20) out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c << std::dec;
+				else out << c;
+		}
+	}
+	out << '"';
+	return out.str();
+}
+
+std::string json_number (double value) {
+	if (not std::isfinite(value)) return "null";
+	std::ostringstream out;
+	out << std::setprecision(10) << value;
+	return out.str();
+}
+
+BenchmarkReportFields configuration_fields (const BenchmarkConfiguration& config) {
+	return {
+		{"begin_n",      json_number((double) config.begin_n)},
+		{"end_n",        json_number((double) config.end_n)},
+		{"step_n",       json_number((double) config.step_n)},
+		{"sample_count", json_number((double) config.sample_count)},
+		{"iter_count",   json_number((double) config.iter_count)},
+		{"seed",         json_number((double) config.seed)},
+		{"jobs",         json_number((double) utils::resolve_thread_count(config.jobs))},
+		{"pin_workers",  config.pin_workers ? "true" : "false"},
+		{"warmup",       json_number((double) config.measure.warmup)},
+		{"target_time",  json_number(config.measure.target_time)},
+	};
+}
+
+/**
+ * The json object of timing statistics, with every per call time.
+ */
+static std::string json_timing (const utils::TimingStatistics& timing) {
+	std::ostringstream out;
+	out << "{\"min\": " << json_number(timing.min)
+		<< ", \"median\": " << json_number(timing.median)
+		<< ", \"p90\": " << json_number(timing.p90)
+		<< ", \"mean\": " << json_number(timing.mean)
+		<< ", \"stddev\": " << json_number(timing.stddev)
+		<< ", \"times\": [";
+	for (size_t i = 0 ; i < timing.times.size() ; i++) out << (i ? ", " : "") << json_number(timing.times[i]);
+	out << "]}";
+	return out.str();
+}
+
+template <typename T>
+static std::string json_array (const std::vector<T>& values) {
+	std::ostringstream out;
+	out << "[";
+	for (size_t i = 0 ; i < values.size() ; i++) out << (i ? ", " : "") << json_number((double) values[i]);
+	out << "]";
+	return out.str();
+}
+
+static std::string csv_timing (const utils::TimingStatistics& timing) {
+	std::ostringstream out;
+	out << json_number(timing.min) << "," << json_number(timing.median) << "," << json_number(timing.p90)
+		<< "," << json_number(timing.mean) << "," << json_number(timing.stddev) << "," << timing.repetitions();
+	return out.str();
+}
+
+/**
+ * The i-th value of a per-iteration vector, empty when it was not collected.
+ */
+template <typename T>
+static std::string csv_at (const std::vector<T>& values, size_t i) {
+	return (i < values.size()) ? json_number((double) values[i]) : "";
+}
+
+void BenchmarkReport::begin (const std::string& benchmark, const BenchmarkReportFields& configuration, const std::string& csv_header) {
+	begun = true;
+	const BenchmarkEnvironment env = BenchmarkEnvironment::current();
+	const BenchmarkReportFields environment = {
+			{"git_revision",     json_string(env.git_revision)},
+			{"host",             json_string(env.host)},
+			{"system",           json_string(env.system)},
+			{"compiler",         json_string(env.compiler)},
+			{"hardware_threads", json_number((double) env.hardware_threads)},
+	};
+
+	if (format == BenchmarkFormat::json) {
+		auto print_object = [this] (const BenchmarkReportFields& fields) {
+			stream << "{";
+			for (size_t i = 0 ; i < fields.size() ; i++) stream << (i ? ", " : "") << json_string(fields[i].first) << ": " << fields[i].second;
+			stream << "}";
+		};
+		stream << "{" << std::endl;
+		stream << "\"benchmark\": " << json_string(benchmark) << "," << std::endl;
+		stream << "\"environment\": "; print_object(environment); stream << "," << std::endl;
+		stream << "\"configuration\": "; print_object(configuration); stream << "," << std::endl;
+		stream << "\"rows\": [" << std::flush;
+	} else if (format == BenchmarkFormat::csv) {
+		stream << "# benchmark = " << benchmark << std::endl;
+		for (const auto& field : environment) stream << "# " << field.first << " = " << field.second << std::endl;
+		for (const auto& field : configuration) stream << "# " << field.first << " = " << field.second << std::endl;
+		stream << csv_header << std::endl;
+	}
+}
+
+void BenchmarkReport::begin_json_row () {
+	stream << (row_count++ ? "," : "") << std::endl;
+}
+
+void BenchmarkReport::begin_age_latency (const BenchmarkReportFields& configuration) {
+	begin("age_latency", configuration,
+			"dt,n,m,seed,sum_n,age_latency,iterations,status,total_time,"
+			"time_min,time_median,time_p90,time_mean,time_stddev,time_reps,"
+			"iteration,upper_bound,lower_bound,vertex_count,edge_count,candidate_count,graph_time,path_time");
+}
+
+void BenchmarkReport::begin_expansion (const BenchmarkReportFields& configuration) {
+	begin("expansion", configuration,
+			"function,dt,hpf,n,m,seed,sum_n,vertex_count,edge_count,memory,case1,case2,case3,"
+			"time_min,time_median,time_p90,time_mean,time_stddev,time_reps");
+}
+
+void BenchmarkReport::add_age_latency_row (const AgeLatencyBenchmarkResult& bench) {
+
+	if (format == BenchmarkFormat::json) {
+		begin_json_row();
+		stream << "{\"dt\": " << bench.dt << ", \"n\": " << bench.n << ", \"m\": " << bench.m
+				<< ", \"sum_n\": " << json_number(bench.sum_n)
+				<< ", \"time\": " << json_number(bench.time)
+				<< ", \"checked_time\": " << json_number(bench.checked_time)
+				<< ", \"gap_time\": " << json_number(bench.gap_time)
+				<< ", \"iter\": " << json_number(bench.iter)
+				<< ", \"gap_saved_iter\": " << json_number(bench.gap_saved_iter)
+				<< ", \"cold_time\": " << json_number(bench.cold_time)
+				<< ", \"warm_time\": " << json_number(bench.warm_time)
+				<< ", \"warm_saved_iter\": " << json_number(bench.warm_saved_iter)
+				<< ", \"batch_time\": " << json_number(bench.batch_time)
+				<< ", \"size\": " << json_number(bench.size)
+				<< ", \"bound\": " << json_number(bench.bound)
+				<< ", \"g_ctime\": " << json_number(bench.g_ctime)
+				<< ", \"p_ctime\": " << json_number(bench.p_ctime)
+				<< ", \"samples\": [";
+		for (size_t s = 0 ; s < bench.samples.size() ; s++) {
+			const AgeLatencySample& sample = bench.samples[s];
+			const AgeLatencyResult& res = sample.result;
+			std::ostringstream status;
+			status << res.status;
+			stream << (s ? ", " : "") << std::endl
+					<< "  {\"seed\": " << sample.seed
+					<< ", \"sum_n\": " << res.sum_n
+					<< ", \"age_latency\": " << res.age_latency
+					<< ", \"iterations\": " << res.iterations
+					<< ", \"status\": " << json_string(status.str())
+					<< ", \"best_lower_bound\": " << res.best_lower_bound
+					<< ", \"best_upper_bound\": " << res.best_upper_bound
+					<< ", \"total_time\": " << json_number(res.total_time)
+					<< ", \"graph_computation_time\": " << json_number(res.graph_computation_time)
+					<< ", \"path_computation_time\": " << json_number(res.path_computation_time)
+					<< ", \"upper_bounds\": " << json_array(res.upper_bounds)
+					<< ", \"lower_bounds\": " << json_array(res.lower_bounds)
+					<< ", \"expansion_vertex_count\": " << json_array(res.expansion_vertex_count)
+					<< ", \"expansion_edge_count\": " << json_array(res.expansion_edge_count)
+					<< ", \"candidate_count\": " << json_array(res.candidate_count)
+					<< ", \"graph_computation_times\": " << json_array(res.graph_computation_times)
+					<< ", \"path_computation_times\": " << json_array(res.path_computation_times)
+					<< ", \"timing\": " << json_timing(sample.timing) << "}";
+		}
+		stream << "]}" << std::flush;
+	} else if (format == BenchmarkFormat::csv) {
+		for (const AgeLatencySample& sample : bench.samples) {
+			const AgeLatencyResult& res = sample.result;
+			for (size_t i = 0 ; i < res.iterations ; i++) {
+				stream << bench.dt << "," << bench.n << "," << bench.m << "," << sample.seed << "," << res.sum_n
+						<< "," << res.age_latency << "," << res.iterations << "," << res.status << "," << json_number(res.total_time)
+						<< "," << csv_timing(sample.timing) << "," << i
+						<< "," << csv_at(res.upper_bounds, i) << "," << csv_at(res.lower_bounds, i)
+						<< "," << csv_at(res.expansion_vertex_count, i) << "," << csv_at(res.expansion_edge_count, i)
+						<< "," << csv_at(res.candidate_count, i)
+						<< "," << csv_at(res.graph_computation_times, i) << "," << csv_at(res.path_computation_times, i)
+						<< std::endl;
+			}
+		}
+	}
+}
+
+void BenchmarkReport::add_expansion_row (const std::string& function, LETDatasetType dt, bool harmonized_periodicity, size_t n, size_t m, const ExpansionBenchmarkResult& bench) {
+
+	if (format == BenchmarkFormat::json) {
+		begin_json_row();
+		stream << "{\"function\": " << json_string(function) << ", \"dt\": " << dt << ", \"hpf\": " << (harmonized_periodicity ? "true" : "false")
+				<< ", \"n\": " << n << ", \"m\": " << m
+				<< ", \"sample_count\": " << bench.sample_count
+				<< ", \"sum_n\": " << json_number(bench.sum_n)
+				<< ", \"average_time\": " << json_number(bench.average_time)
+				<< ", \"average_memory\": " << json_number(bench.average_memory)
+				<< ", \"total_vertex_count\": " << bench.total_vertex_count
+				<< ", \"total_edge_count\": " << bench.total_edge_count
+				<< ", \"samples\": [";
+		for (size_t s = 0 ; s < bench.samples.size() ; s++) {
+			const ExpansionSample& sample = bench.samples[s];
+			stream << (s ? ", " : "") << std::endl
+					<< "  {\"seed\": " << sample.seed
+					<< ", \"sum_n\": " << sample.sum_n
+					<< ", \"vertex_count\": " << sample.vertex
+					<< ", \"edge_count\": " << sample.edge
+					<< ", \"memory\": " << json_number(sample.memory)
+					<< ", \"case1\": " << sample.algo2_stats.total_case1
+					<< ", \"case2\": " << sample.algo2_stats.total_case2
+					<< ", \"case3\": " << sample.algo2_stats.total_case3
+					<< ", \"timing\": " << json_timing(sample.timing) << "}";
+		}
+		stream << "]}" << std::flush;
+	} else if (format == BenchmarkFormat::csv) {
+		for (const ExpansionSample& sample : bench.samples) {
+			stream << function << "," << dt << "," << harmonized_periodicity << "," << n << "," << m << "," << sample.seed
+					<< "," << sample.sum_n << "," << sample.vertex << "," << sample.edge << "," << json_number(sample.memory)
+					<< "," << sample.algo2_stats.total_case1 << "," << sample.algo2_stats.total_case2 << "," << sample.algo2_stats.total_case3
+					<< "," << csv_timing(sample.timing) << std::endl;
+		}
+	}
+}
+
+void BenchmarkReport::close () {
+	if (closed) return;
+	closed = true;
+	if (format == BenchmarkFormat::json and begun) {
+		stream << std::endl << "]}" << std::endl;
+	}
+}
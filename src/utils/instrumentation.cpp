@@ -0,0 +1,30 @@
+/*
+ * instrumentation.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <instrumentation.h>
+
+InstrumentationCounters& InstrumentationCounters::local () {
+	static thread_local InstrumentationCounters current;
+	return current;
+}
+
+void InstrumentationCounters::add_dependency_time (DEPENDENCY_ID did, double ms) {
+	if (dependency_time.size() <= (size_t) did) dependency_time.resize(did + 1, 0.0);
+	dependency_time[did] += ms;
+}
+
+InstrumentationCounters& InstrumentationCounters::operator+= (const InstrumentationCounters& r) {
+	algorithm2 = algorithm2 + r.algorithm2;
+	for (size_t c = 0 ; c < 3 ; c++) case_edges[c] += r.case_edges[c];
+	theta_scanned += r.theta_scanned;
+	theta_kept += r.theta_kept;
+	if (dependency_time.size() < r.dependency_time.size()) dependency_time.resize(r.dependency_time.size(), 0.0);
+	for (size_t did = 0 ; did < r.dependency_time.size() ; did++) dependency_time[did] += r.dependency_time[did];
+	for (const auto& phase : r.phase_time) phase_time[phase.first] += phase.second;
+	pattern_cache += r.pattern_cache;
+	return *this;
+}
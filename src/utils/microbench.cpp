@@ -0,0 +1,214 @@
+/*
+ * microbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <microbench.h>
+#include <verbose.h>
+#include <letitgo.h>
+#include <algorithm2.h>
+#include <repetition_vector.h>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * Sink of new_algorithm2 that only counts, the kernel is timed without the graph insertion.
+ */
+struct CountingConstraintSink {
+	size_t count = 0;
+	inline void add (const Constraint&) { count++; }
+};
+
+/**
+ * The fixed inputs: one model per dataset type and a random K, all seeded.
+ */
+struct MicrobenchInput {
+	std::string name;
+	LETDatasetType dt;
+	size_t n, m, seed;
+};
+
+static const std::vector<MicrobenchInput> microbench_inputs = {
+		{"automotive", LETDatasetType::automotive_dt, 20, 80, 123},
+		{"harmonic",   LETDatasetType::harmonic_dt,   20, 80, 123},
+		{"generic",    LETDatasetType::generic_dt,    10, 25, 123},
+};
+
+std::vector<MicrobenchResult> run_microbenchmarks (const std::string& filter, const utils::MeasureOptions& measure) {
+
+	std::vector<MicrobenchResult> results;
+	auto run = [&] (const std::string& name, size_t edges, size_t executions, const std::function<void()>& fun, const std::function<void()>& setup = nullptr) {
+		if (name.find(filter) == std::string::npos) return;
+		VERBOSE_INFO("Run " << name);
+		MicrobenchResult res;
+		res.name = name;
+		res.edges = edges;
+		res.executions = executions;
+		res.timing = utils::measure(fun, measure, setup);
+		results.push_back(res);
+	};
+
+	for (const MicrobenchInput& input : microbench_inputs) {
+		const LETModel model = Generator::getInstance().generate(input.dt, input.n, input.m, input.seed);
+		const PeriodicityVector K = generate_random_periodicity_vector(model, input.seed);
+		const ModelAnalysisContext context (model);
+		const DEPENDENCY_ID dependency_count = (DEPENDENCY_ID) context.getDependencyCount();
+		const std::string suffix = "/" + input.name;
+
+		size_t sum_k = 0;
+		for (EXECUTION_COUNT k : K) sum_k += k;
+
+		// Reference graphs of the input: constraints only, then with start and finish.
+		PartialConstraintGraph constraints;
+		for (DEPENDENCY_ID did = 0 ; did < dependency_count ; did++) add_constraints(context, K, did, constraints);
+		PartialConstraintGraph graph = constraints;
+		add_start_finish(model, K, graph);
+		const size_t constraint_count = constraints.getConstraints().size();
+		const size_t edge_count = graph.getConstraints().size();
+		const size_t execution_count = graph.getExecutions().size();
+
+		PartialConstraintGraph target;
+		auto reset_target = [&target] () { target = PartialConstraintGraph(); };
+		auto copy_constraints = [&target, &constraints] () { target = constraints; };
+
+		run("add_constraints" + suffix, constraint_count, sum_k, [&] () {
+			for (DEPENDENCY_ID did = 0 ; did < dependency_count ; did++) add_constraints(context, K, did, target);
+		}, reset_target);
+
+		// Each case on its own dependencies, rows ai are the executions.
+		std::vector<std::vector<DEPENDENCY_ID>> cases (4);
+		for (DEPENDENCY_ID did = 0 ; did < dependency_count ; did++) cases[algorithm2_case(context.getKernel(did, K))].push_back(did);
+		for (size_t c = 1 ; c <= 3 ; c++) {
+			if (cases[c].empty()) continue;
+			CountingConstraintSink sink;
+			size_t rows = 0;
+			for (DEPENDENCY_ID did : cases[c]) {
+				new_algorithm2(context, K, did, sink);
+				rows += K[context.getDependency(did).ti];
+			}
+			run("new_algorithm2/case" + std::to_string(c) + suffix, sink.count, rows, [&context, &K, &cases, c] () {
+				CountingConstraintSink sink;
+				for (DEPENDENCY_ID did : cases[c]) new_algorithm2(context, K, did, sink);
+			});
+		}
+
+		run("add_start_finish" + suffix, edge_count - constraint_count, sum_k, [&] () {
+			add_start_finish(model, K, target);
+		}, copy_constraints);
+
+		run("topologicalOrder" + suffix, edge_count, execution_count, [&graph] () { topologicalOrder(graph); });
+		run("FindLongestPath" + suffix, edge_count, execution_count, [&graph] () { FindLongestPath(graph); });
+
+		PartialConstraintGraph lowerbounds;
+		for (DEPENDENCY_ID did = 0 ; did < dependency_count ; did++) add_lowerbounds(context, K, did, lowerbounds);
+		run("add_lowerbounds" + suffix, lowerbounds.getConstraints().size(), sum_k, [&] () {
+			for (DEPENDENCY_ID did = 0 ; did < dependency_count ; did++) add_lowerbounds(context, K, did, target);
+		}, reset_target);
+
+		run("compute_repetition_vector" + suffix, model.getDependencyCount(), context.getSumN(), [&model] () {
+			compute_repetition_vector(model);
+		});
+
+		// One Diophantine equation per dependency, the ones of algorithm 2 case 3.
+		std::vector<std::pair<INTEGER_TIME_UNIT, INTEGER_TIME_UNIT>> equations;
+		for (DEPENDENCY_ID did = 0 ; did < dependency_count ; did++) {
+			const Theorem6Kernel kernel = context.getKernel(did, K);
+			equations.push_back({kernel.Tj, kernel.gcdK});
+		}
+		run("extended_euclide" + suffix, equations.size(), 0, [&equations] () {
+			for (const auto& e : equations) extended_euclide<INTEGER_TIME_UNIT>(e.first, e.second, std::gcd(e.first, e.second));
+		});
+		run("opt_extended_euclide" + suffix, equations.size(), 0, [&equations] () {
+			for (const auto& e : equations) opt_extended_euclide<INTEGER_TIME_UNIT>(e.first, e.second, std::gcd(e.first, e.second));
+		});
+	}
+
+	return results;
+}
+
+std::map<std::string, double> read_microbench_baseline (std::istream& input) {
+	std::map<std::string, double> baseline;
+	for (std::string line ; std::getline(input, line) ; ) {
+		if (line.empty() or line[0] == '#') continue;
+		std::istringstream row (line);
+		std::string name;
+		size_t repetitions;
+		double median;
+		if (row >> name >> repetitions >> median) baseline[name] = median;
+	}
+	return baseline;
+}
+
+/**
+ * Nanoseconds per item with one decimal, - when the kernel has no such item.
+ */
+static std::string per_item (size_t count, double ns) {
+	if (count == 0) return "-";
+	std::ostringstream out;
+	out << std::setprecision(1) << std::fixed << ns;
+	return out.str();
+}
+
+size_t main_microbench (const MicrobenchConfiguration& config) {
+
+	std::map<std::string, double> baseline;
+	if (config.baseline.size()) {
+		std::ifstream input (config.baseline);
+		VERBOSE_ASSERT(input.good(), "Cannot read the baseline " << config.baseline);
+		baseline = read_microbench_baseline(input);
+	}
+
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "########## LET it Go Kernel Microbenchmarks                                              ###" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+	std::cout << "#     filter = " << config.filter << "" << std::endl;
+	std::cout << "#     warmup = " << config.measure.warmup << "" << std::endl;
+	std::cout << "#     target_time = " << config.measure.target_time << "" << std::endl;
+	std::cout << "#     min_repetitions = " << config.measure.min_repetitions << "" << std::endl;
+	std::cout << "#     baseline = " << config.baseline << "" << std::endl;
+	std::cout << "#     threshold = " << config.threshold << "" << std::endl;
+	std::cout << "############################################################################################" << std::endl;
+
+	std::cout << "#" << std::setw(39) << "name"
+			<< std::setw(7)  << "reps"
+			<< std::setw(12) << "median"
+			<< std::setw(12) << "p90"
+			<< std::setw(10) << "edges"
+			<< std::setw(10) << "execs"
+			<< std::setw(10) << "ns/edge"
+			<< std::setw(10) << "ns/exec";
+	if (baseline.size()) std::cout << std::setw(12) << "base" << std::setw(8) << "ratio";
+	std::cout << std::endl;
+
+	size_t slowdowns = 0;
+	for (const MicrobenchResult& res : run_microbenchmarks(config.filter, config.measure)) {
+		std::cout << std::setw(40) << res.name
+				<< std::setw(7)  << res.timing.repetitions()
+				<< std::setw(12) << std::setprecision(5) << std::fixed << res.timing.median
+				<< std::setw(12) << std::setprecision(5) << std::fixed << res.timing.p90
+				<< std::setw(10) << res.edges
+				<< std::setw(10) << res.executions
+				<< std::setw(10) << per_item(res.edges, res.ns_per_edge())
+				<< std::setw(10) << per_item(res.executions, res.ns_per_execution());
+		const auto base = baseline.find(res.name);
+		if (base != baseline.end() and base->second > 0) {
+			const double ratio = res.timing.median / base->second;
+			std::cout << std::setw(12) << std::setprecision(5) << std::fixed << base->second
+					<< std::setw(8) << std::setprecision(2) << std::fixed << ratio;
+			if (ratio > 1.0 + config.threshold) {
+				std::cout << "  SLOWDOWN";
+				slowdowns++;
+			}
+		}
+		std::cout << std::endl;
+	}
+
+	if (baseline.size()) {
+		std::cout << "# " << slowdowns << " slowdowns beyond " << 100.0 * config.threshold << "%" << std::endl;
+	}
+	return slowdowns;
+}
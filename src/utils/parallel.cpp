@@ -0,0 +1,249 @@
+/*
+ * parallel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <parallel.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <numeric>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+size_t utils::hardware_thread_count () {
+	const size_t count = std::thread::hardware_concurrency();
+	return count ? count : 1;
+}
+
+void utils::parallel_for (size_t count, size_t thread_count, const std::function<void(size_t)>& body) {
+
+	thread_count = std::min(resolve_thread_count(thread_count), count);
+
+	if (thread_count <= 1) {
+		for (size_t i = 0 ; i < count ; i++) body(i);
+		return;
+	}
+
+	std::atomic<size_t> next (0);
+	std::exception_ptr failure;
+	std::mutex failure_mutex;
+
+	auto worker = [&] () {
+		for (size_t i = next++ ; i < count ; i = next++) {
+			try {
+				body(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock (failure_mutex);
+				if (not failure) failure = std::current_exception();
+				next = count;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count - 1);
+	for (size_t t = 1 ; t < thread_count ; t++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& t : threads) {
+		t.join();
+	}
+
+	if (failure) std::rethrow_exception(failure);
+}
+
+namespace {
+
+/**
+ * Reusable barrier for a fixed number of threads.
+ */
+class PhaseBarrier {
+	std::mutex mutex;
+	std::condition_variable released;
+	const size_t count;
+	size_t waiting = 0;
+	size_t generation = 0;
+public:
+	explicit PhaseBarrier (size_t count) : count (count) {}
+	void wait () {
+		std::unique_lock<std::mutex> lock (mutex);
+		const size_t current = generation;
+		if (++waiting == count) {
+			waiting = 0;
+			generation++;
+			released.notify_all();
+			return;
+		}
+		released.wait(lock, [this, current] { return generation != current; });
+	}
+};
+
+} // namespace
+
+void utils::parallel_for_phases (const std::vector<size_t>& counts, size_t thread_count, const std::function<void(size_t, size_t)>& body) {
+
+	const size_t widest = counts.empty() ? 0 : *std::max_element(counts.begin(), counts.end());
+	thread_count = std::min(resolve_thread_count(thread_count), widest);
+
+	if (thread_count <= 1) {
+		for (size_t phase = 0 ; phase < counts.size() ; phase++) {
+			for (size_t i = 0 ; i < counts[phase] ; i++) body(phase, i);
+		}
+		return;
+	}
+
+	std::vector<std::atomic<size_t>> next (counts.size());
+	for (std::atomic<size_t>& n : next) n = 0;
+	std::atomic<bool> stop (false);
+	std::exception_ptr failure;
+	std::mutex failure_mutex;
+	PhaseBarrier barrier (thread_count);
+
+	auto worker = [&] () {
+		for (size_t phase = 0 ; phase < counts.size() ; phase++) {
+			const size_t count = counts[phase];
+			for (size_t i = next[phase]++ ; not stop and i < count ; i = next[phase]++) {
+				try {
+					body(phase, i);
+				} catch (...) {
+					std::lock_guard<std::mutex> lock (failure_mutex);
+					if (not failure) failure = std::current_exception();
+					stop = true;
+				}
+			}
+			if (phase + 1 < counts.size()) barrier.wait();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count - 1);
+	for (size_t t = 1 ; t < thread_count ; t++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& t : threads) {
+		t.join();
+	}
+
+	if (failure) std::rethrow_exception(failure);
+}
+
+bool utils::pin_current_thread (size_t cpu) {
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu % hardware_thread_count(), &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	(void) cpu;
+	return false;
+#endif
+}
+
+void utils::unpin_current_thread () {
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (size_t cpu = 0 ; cpu < hardware_thread_count() ; cpu++) CPU_SET(cpu, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+size_t utils::work_stealing_for (const std::vector<double>& costs, size_t thread_count, const std::function<void(size_t, size_t)>& body, bool pin_workers) {
+
+	const size_t count = costs.size();
+	thread_count = std::min(resolve_thread_count(thread_count), count);
+
+	if (thread_count <= 1) {
+		if (pin_workers) pin_current_thread(0);
+		for (size_t i = 0 ; i < count ; i++) body(i, 0);
+		if (pin_workers) unpin_current_thread();
+		return 0;
+	}
+
+	// The most expensive items start first, each worker gets a similar share of them.
+	std::vector<size_t> order (count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&costs] (size_t l, size_t r) { return costs[l] > costs[r]; });
+
+	struct WorkQueue {
+		std::deque<size_t> items;
+		std::mutex mutex;
+	};
+	std::vector<WorkQueue> queues (thread_count);
+	for (size_t k = 0 ; k < count ; k++) queues[k % thread_count].items.push_back(order[k]);
+
+	std::atomic<size_t> stolen (0);
+	std::atomic<bool> stop (false);
+	std::exception_ptr failure;
+	std::mutex failure_mutex;
+
+	auto take = [&queues, &stolen] (size_t worker, size_t& item) {
+		{
+			std::lock_guard<std::mutex> lock (queues[worker].mutex);
+			if (not queues[worker].items.empty()) {
+				item = queues[worker].items.front();
+				queues[worker].items.pop_front();
+				return true;
+			}
+		}
+		// Nothing is ever added, a victim that looks empty stays empty.
+		while (true) {
+			size_t victim = worker, longest = 0;
+			for (size_t q = 0 ; q < queues.size() ; q++) {
+				std::lock_guard<std::mutex> lock (queues[q].mutex);
+				if (queues[q].items.size() > longest) {
+					longest = queues[q].items.size();
+					victim = q;
+				}
+			}
+			if (longest == 0) return false;
+			std::lock_guard<std::mutex> lock (queues[victim].mutex);
+			if (queues[victim].items.empty()) continue;
+			item = queues[victim].items.back();
+			queues[victim].items.pop_back();
+			stolen++;
+			return true;
+		}
+	};
+
+	auto worker = [&] (size_t w) {
+		if (pin_workers) pin_current_thread(w);
+		size_t item;
+		while (not stop and take(w, item)) {
+			try {
+				body(item, w);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock (failure_mutex);
+				if (not failure) failure = std::current_exception();
+				stop = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count - 1);
+	for (size_t t = 1 ; t < thread_count ; t++) {
+		threads.emplace_back(worker, t);
+	}
+	worker(0);
+	for (std::thread& t : threads) {
+		t.join();
+	}
+	if (pin_workers) unpin_current_thread();
+
+	if (failure) std::rethrow_exception(failure);
+	return stolen;
+}
@@ -0,0 +1,67 @@
+/*
+ * timing.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#include <timing.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/**
+ * Nearest rank percentile of sorted times.
+ */
+static double percentile (const std::vector<double>& sorted, double p) {
+	const size_t rank = (size_t) std::ceil(p * (double) sorted.size());
+	return sorted[std::max(rank, (size_t) 1) - 1];
+}
+
+utils::TimingStatistics::TimingStatistics (std::vector<double> measured) : times(std::move(measured)) {
+	if (times.empty()) return;
+
+	std::vector<double> sorted = times;
+	std::sort(sorted.begin(), sorted.end());
+	min = sorted.front();
+	median = percentile(sorted, 0.5);
+	p90 = percentile(sorted, 0.9);
+	mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / (double) sorted.size();
+
+	double squares = 0;
+	for (double t : sorted) squares += (t - mean) * (t - mean);
+	stddev = std::sqrt(squares / (double) sorted.size());
+}
+
+utils::TimingStatistics utils::operator+ (const TimingStatistics& l, const TimingStatistics& r) {
+	std::vector<double> times = l.times;
+	times.insert(times.end(), r.times.begin(), r.times.end());
+	return TimingStatistics(std::move(times));
+}
+
+utils::TimingStatistics utils::measure (const std::function<void()>& fun, const MeasureOptions& options, const std::function<void()>& setup) {
+
+	for (size_t i = 0 ; i < options.warmup ; i++) {
+		if (setup) setup();
+		fun();
+	}
+
+	std::vector<double> times;
+	auto timed_call = [&fun, &setup, &times] () {
+		if (setup) setup();
+		const TimePoint t1 = now();
+		fun();
+		times.push_back(elapsed_ms(t1));
+	};
+
+	timed_call();
+	size_t repetitions = options.min_repetitions;
+	if (options.target_time > 0) {
+		const double first = std::max(times.front(), 1e-6);
+		repetitions = std::max(repetitions, (size_t) std::ceil(options.target_time / first));
+	}
+	repetitions = std::min(repetitions, std::max(options.max_repetitions, options.min_repetitions));
+
+	while (times.size() < repetitions) timed_call();
+	return TimingStatistics(std::move(times));
+}
@@ -0,0 +1,98 @@
+/*
+ * AgeLatencyBatchTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE AgeLatencyBatchTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include <atomic>
+
+BOOST_AUTO_TEST_SUITE(AgeLatencyBatchTest)
+
+BOOST_AUTO_TEST_CASE(test_work_stealing_for) {
+	for (size_t thread_count : {1, 2, 4, 8}) {
+		// Skewed costs, a few items are much longer than the others.
+		std::vector<double> costs (200);
+		for (size_t i = 0 ; i < costs.size() ; i++) costs[i] = (i % 17 == 0) ? 1000.0 : (double) i;
+
+		std::vector<std::atomic<size_t>> visits (costs.size());
+		std::vector<size_t> workers (costs.size());
+		utils::work_stealing_for(costs, thread_count, [&visits, &workers] (size_t i, size_t worker) {
+			visits[i]++;
+			workers[i] = worker;
+		});
+		for (size_t i = 0 ; i < visits.size() ; i++) {
+			BOOST_CHECK_EQUAL(visits[i], 1);
+			BOOST_CHECK_LT(workers[i], thread_count);
+		}
+	}
+	BOOST_CHECK_EQUAL(utils::work_stealing_for({}, 4, [] (size_t, size_t) {}), 0);
+	BOOST_CHECK_THROW(utils::work_stealing_for(std::vector<double>(10, 1.0), 4, [] (size_t i, size_t) {
+		if (i == 5) throw std::runtime_error("failure");
+	}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_matches_sequential) {
+	std::vector<LETModel> models;
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			models.push_back(Generator::getInstance().generate(dt, 5 + 2 * it, 10 + 4 * it, 123 + it));
+		}
+	}
+
+	for (size_t thread_count : {1, 4}) {
+		const auto results = ComputeAgeLatencyBatch(models, AgeLatencyOptions(), thread_count);
+		BOOST_REQUIRE_EQUAL(results.size(), models.size());
+		for (size_t i = 0 ; i < models.size() ; i++) {
+			const auto expected = ComputeAgeLatency(models[i]);
+			BOOST_CHECK_EQUAL(results[i].n, models[i].getTaskCount());
+			BOOST_CHECK_EQUAL(results[i].age_latency, expected.age_latency);
+			BOOST_CHECK_EQUAL(results[i].iterations, expected.iterations);
+			BOOST_CHECK(results[i].periodicity_vector == expected.periodicity_vector);
+			BOOST_CHECK_GE(results[i].total_time, results[i].context_setup_time);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_with_engine) {
+	std::vector<LETModel> models;
+	for (size_t it = 0 ; it < 8 ; it ++ ) {
+		models.push_back(Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 456 + it));
+	}
+
+	// One incremental engine per call, the calls run concurrently.
+	AgeLatencyFun incremental = [] (const LETModel &model, GenerateExpansionFun, const AgeLatencyOptions& options) {
+		return ComputeAgeLatencyWithEngine(model, incremental_expansion_engine(), options);
+	};
+	const auto results = ComputeAgeLatencyBatch(models, AgeLatencyOptions::checked(), 4, incremental);
+	for (size_t i = 0 ; i < models.size() ; i++) {
+		BOOST_CHECK_EQUAL(results[i].age_latency, ComputeAgeLatency(models[i]).age_latency);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_with_expansion) {
+	std::vector<LETModel> models;
+	for (size_t it = 0 ; it < 6 ; it ++ ) {
+		models.push_back(Generator::getInstance().generate(LETDatasetType::automotive_dt, 8, 16, 789 + it));
+	}
+
+	// Every iteration of every analysis goes through the given expansion.
+	std::atomic<size_t> calls (0);
+	GenerateExpansionFun counted = [&calls] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		calls++;
+		return new_generate_partial_constraint_graph(context, K);
+	};
+	const auto results = ComputeAgeLatencyBatch(models, AgeLatencyOptions(), 3, (AgeLatencyFun) ComputeAgeLatency, counted);
+	size_t iterations = 0;
+	for (size_t i = 0 ; i < models.size() ; i++) {
+		BOOST_CHECK_EQUAL(results[i].age_latency, ComputeAgeLatency(models[i]).age_latency);
+		iterations += results[i].iterations;
+	}
+	BOOST_CHECK_EQUAL(calls.load(), iterations);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
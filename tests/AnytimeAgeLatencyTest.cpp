@@ -0,0 +1,96 @@
+/*
+ * AnytimeAgeLatencyTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE AnytimeAgeLatencyTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+/**
+ * Whatever stopped it, the answer must stay between the proven bounds.
+ */
+static void check_bounds (const AgeLatencyResult& res, const AgeLatencyResult& reference) {
+	BOOST_CHECK_LE(res.best_lower_bound, reference.age_latency);
+	BOOST_CHECK_GE(res.best_upper_bound, reference.age_latency);
+	BOOST_CHECK_EQUAL(res.age_latency, res.best_upper_bound);
+	BOOST_CHECK_EQUAL(res.lower_bounds.size(), res.iterations);
+	BOOST_CHECK_EQUAL(res.best_upper_bound, *std::min_element(res.upper_bounds.begin(), res.upper_bounds.end()));
+	if (res.status == AgeLatencyStatus::exact) {
+		BOOST_CHECK_EQUAL(res.age_latency, reference.age_latency);
+		BOOST_CHECK_EQUAL(res.best_lower_bound, res.age_latency);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(AnytimeAgeLatencyTest)
+
+BOOST_AUTO_TEST_CASE(test_default_is_exact) {
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 123 + it);
+		auto res = ComputeAgeLatency(model);
+		BOOST_CHECK_EQUAL(res.status, AgeLatencyStatus::exact);
+		BOOST_CHECK_EQUAL(res.best_lower_bound, res.age_latency);
+		BOOST_CHECK_EQUAL(res.best_upper_bound, res.age_latency);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_iteration_cap) {
+	AgeLatencyOptions options;
+	options.max_iterations = 1;
+
+	size_t truncated = 0;
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto reference = ComputeAgeLatency(model);
+			auto res = ComputeAgeLatency(model, generate_partial_constraint_graph, options);
+
+			BOOST_CHECK_EQUAL(res.iterations, 1);
+			check_bounds(res, reference);
+			if (res.status == AgeLatencyStatus::truncated) truncated++;
+			else BOOST_CHECK_EQUAL(res.status, AgeLatencyStatus::exact);
+		}
+	}
+	BOOST_TEST_MESSAGE("Truncated: " << truncated);
+}
+
+BOOST_AUTO_TEST_CASE(test_time_budget) {
+	AgeLatencyOptions options;
+	options.time_budget = 1e-6;
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 123 + it);
+		auto reference = ComputeAgeLatency(model);
+		auto res = ComputeAgeLatency(model, generate_partial_constraint_graph, options);
+
+		// The first iteration always runs, the budget is spent before a second one.
+		BOOST_CHECK_EQUAL(res.iterations, 1);
+		check_bounds(res, reference);
+		BOOST_CHECK(res.status != AgeLatencyStatus::within_epsilon);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_epsilon) {
+	for (double epsilon : {0.01, 0.1, 0.5, 1.0}) {
+		AgeLatencyOptions options;
+		options.epsilon = epsilon;
+		for (size_t it = 0 ; it < 10 ; it ++ ) {
+			LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 123 + it);
+			auto reference = ComputeAgeLatency(model);
+			auto res = ComputeAgeLatency(model, generate_partial_constraint_graph, options);
+
+			check_bounds(res, reference);
+			BOOST_CHECK_LE(res.iterations, reference.iterations);
+			BOOST_CHECK(res.status != AgeLatencyStatus::truncated);
+			if (res.status == AgeLatencyStatus::within_epsilon) {
+				BOOST_CHECK(res.closed_by_bounds);
+				BOOST_CHECK_LE((double) (res.best_upper_bound - res.best_lower_bound), epsilon * (double) res.best_upper_bound);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
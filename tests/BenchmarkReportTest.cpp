@@ -0,0 +1,105 @@
+/*
+ * BenchmarkReportTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE BenchmarkReportTest
+#include <boost/test/unit_test.hpp>
+#include <benchmark_report.h>
+#include <algorithm>
+#include <sstream>
+
+static size_t count_lines (const std::string& text, bool comments) {
+	std::istringstream in (text);
+	size_t count = 0;
+	for (std::string line ; std::getline(in, line) ; ) {
+		if (not line.empty() and (line[0] == '#') == comments) count++;
+	}
+	return count;
+}
+
+BOOST_AUTO_TEST_SUITE(BenchmarkReportTest)
+
+BOOST_AUTO_TEST_CASE(test_json_literals) {
+	BOOST_CHECK_EQUAL(json_string("plain"), "\"plain\"");
+	BOOST_CHECK_EQUAL(json_string("a\"b\\c\nd"), "\"a\\\"b\\\\c\\nd\"");
+	BOOST_CHECK_EQUAL(json_string(std::string(1, '\x01')), "\"\\u0001\"");
+	BOOST_CHECK_EQUAL(json_number(42), "42");
+	BOOST_CHECK_EQUAL(json_number(0.5), "0.5");
+	BOOST_CHECK_EQUAL(json_number(std::nan("")), "null");
+	BOOST_CHECK(str2format("json") == BenchmarkFormat::json);
+	BOOST_CHECK(str2format("csv") == BenchmarkFormat::csv);
+	BOOST_CHECK(str2format("text") == BenchmarkFormat::text);
+}
+
+BOOST_AUTO_TEST_CASE(test_age_latency_report) {
+	size_t sample_count = 3;
+	AgeLatencyBenchmarkResult bench = benchmark_age_latency (ComputeAgeLatency, sample_count, 1, 6, 10, LETDatasetType::generic_dt, 123);
+	BOOST_REQUIRE_EQUAL(bench.samples.size(), sample_count);
+	size_t iterations = 0;
+	for (size_t i = 0 ; i < sample_count ; i++) {
+		const AgeLatencySample& sample = bench.samples[i];
+		BOOST_CHECK_EQUAL(sample.seed, 123 + i);
+		BOOST_CHECK_EQUAL(sample.result.graph_computation_times.size(), sample.result.iterations);
+		BOOST_CHECK_EQUAL(sample.result.path_computation_times.size(), sample.result.iterations);
+		BOOST_CHECK_GE(sample.timing.repetitions(), 1);
+		iterations += sample.result.iterations;
+	}
+
+	BenchmarkConfiguration config {};
+	config.sample_count = sample_count;
+
+	// One csv line per iteration of every sample, after the header.
+	std::ostringstream csv;
+	{
+		BenchmarkReport report (csv, BenchmarkFormat::csv);
+		report.begin_age_latency(configuration_fields(config));
+		report.add_age_latency_row(bench);
+	}
+	BOOST_CHECK_EQUAL(count_lines(csv.str(), false), 1 + iterations);
+	BOOST_CHECK(csv.str().find("# git_revision = ") != std::string::npos);
+
+	std::ostringstream json;
+	{
+		BenchmarkReport report (json, BenchmarkFormat::json);
+		report.begin_age_latency(configuration_fields(config));
+		report.add_age_latency_row(bench);
+		report.add_age_latency_row(bench);
+	}
+	const std::string text = json.str();
+	BOOST_CHECK_EQUAL(text.front(), '{');
+	BOOST_CHECK_EQUAL(std::count(text.begin(), text.end(), '{'), std::count(text.begin(), text.end(), '}'));
+	BOOST_CHECK_EQUAL(std::count(text.begin(), text.end(), '['), std::count(text.begin(), text.end(), ']'));
+	BOOST_CHECK(text.find("\"seed\": 125") != std::string::npos);
+	BOOST_CHECK(text.find("\"path_computation_times\": [") != std::string::npos);
+	BOOST_CHECK(text.find("\"environment\": {\"git_revision\": ") != std::string::npos);
+	BOOST_CHECK(text.find("]}\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_expansion_report) {
+	size_t sample_count = 2;
+	ExpansionBenchmarkResult bench = benchmark_expansion (new_generate_partial_constraint_graph, sample_count, 1, 5, 10, LETDatasetType::generic_dt, false, 321);
+	BOOST_REQUIRE_EQUAL(bench.samples.size(), sample_count);
+	BOOST_CHECK_EQUAL(bench.samples[1].seed, 322);
+
+	std::ostringstream csv;
+	BenchmarkReport report (csv, BenchmarkFormat::csv);
+	report.begin_expansion({});
+	report.add_expansion_row("new", LETDatasetType::generic_dt, false, 5, 10, bench);
+	report.add_expansion_row("new", LETDatasetType::generic_dt, true, 5, 10, bench);
+	BOOST_CHECK_EQUAL(count_lines(csv.str(), false), 1 + 2 * sample_count);
+	BOOST_CHECK(csv.str().find("new,1,0,5,10,321,") != std::string::npos);
+
+	// Nothing is written in the text format, the binaries print their columns themselves.
+	std::ostringstream text;
+	{
+		BenchmarkReport text_report (text, BenchmarkFormat::text);
+		text_report.begin_expansion({});
+		text_report.add_expansion_row("new", LETDatasetType::generic_dt, false, 5, 10, bench);
+	}
+	BOOST_CHECK(text.str().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
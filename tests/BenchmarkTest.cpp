@@ -6,6 +6,7 @@
 #define BOOST_TEST_MODULE BenchmarkTest
 #include <boost/test/unit_test.hpp>
 #include <letitgo.h>
+#include <cmath>
 #include <map>
 #include <chrono>
 #include <benchmark.h>
@@ -36,6 +37,14 @@ BOOST_AUTO_TEST_CASE(benchmark_AgeLatency) {
 	config.seed          = 123;
 
 	main_benchmark_age_latency ( config ) ;
+
+	// The optional measures run the samples again.
+	config.end_n         = 6;
+	config.measures.checked    = true;
+	config.measures.gap        = true;
+	config.measures.warm_start = true;
+	config.measure_batch = true;
+	main_benchmark_age_latency ( config ) ;
 }
 
 
@@ -50,6 +59,49 @@ BOOST_AUTO_TEST_CASE(test_benchmark_expansion) {
 	ExpansionBenchmarkResult res = benchmark_expansion (generate_partial_constraint_graph, sample_count , iter_count ,  n,  m, LETDatasetType::automotive_dt, false,   seed);
 
 	BOOST_CHECK_GT(res.total_edge_count, 0);
+
+	// The pattern statistics come from a cache of the benchmark, with or without the instrumentation.
+	BOOST_CHECK_EQUAL(res.pattern_stats.lookups, sample_count * m);
+	BOOST_CHECK_EQUAL(res.pattern_stats.lookups, res.pattern_stats.hits + res.pattern_stats.patterns);
+}
+
+BOOST_AUTO_TEST_CASE(test_benchmark_jobs) {
+
+	// Samples run on workers, everything but the timings must be the serial result.
+	size_t sample_count = 6;
+	size_t iter_count = 1;
+	size_t n = 6;
+	size_t m = 10;
+	size_t seed = 321;
+	ExpansionBenchmarkResult serial = benchmark_expansion (new_generate_partial_constraint_graph, sample_count, iter_count, n, m, LETDatasetType::generic_dt, false, seed);
+	ExpansionBenchmarkResult jobs = benchmark_expansion (new_generate_partial_constraint_graph, sample_count, iter_count, n, m, LETDatasetType::generic_dt, false, seed, 4, true);
+
+	BOOST_CHECK_EQUAL(jobs.total_edge_count, serial.total_edge_count);
+	BOOST_CHECK_EQUAL(jobs.total_vertex_count, serial.total_vertex_count);
+	BOOST_CHECK_EQUAL(jobs.sum_n, serial.sum_n);
+	BOOST_CHECK_EQUAL(jobs.average_memory, serial.average_memory);
+	BOOST_CHECK_EQUAL(jobs.algo2_stats.total_case1, serial.algo2_stats.total_case1);
+	BOOST_CHECK_EQUAL(jobs.algo2_stats.total_case2, serial.algo2_stats.total_case2);
+	BOOST_CHECK_EQUAL(jobs.algo2_stats.total_case3, serial.algo2_stats.total_case3);
+
+	AgeLatencyMeasures measures;
+	measures.gap = true;
+	measures.warm_start = true;
+	AgeLatencyBenchmarkResult serial_al = benchmark_age_latency (ComputeAgeLatency, sample_count, iter_count, n, m, LETDatasetType::generic_dt, seed, 1, false, utils::MeasureOptions(), measures);
+	AgeLatencyBenchmarkResult jobs_al = benchmark_age_latency (ComputeAgeLatency, sample_count, iter_count, n, m, LETDatasetType::generic_dt, seed, 4, true, utils::MeasureOptions(), measures);
+	BOOST_CHECK_EQUAL(jobs_al.iter, serial_al.iter);
+	BOOST_CHECK_EQUAL(jobs_al.sum_n, serial_al.sum_n);
+	BOOST_CHECK_EQUAL(jobs_al.size, serial_al.size);
+	BOOST_CHECK_EQUAL(jobs_al.bound, serial_al.bound);
+	BOOST_CHECK_EQUAL(jobs_al.gap_saved_iter, serial_al.gap_saved_iter);
+	BOOST_CHECK_EQUAL(jobs_al.warm_saved_iter, serial_al.warm_saved_iter);
+
+	// Only the production analysis is timed by default.
+	AgeLatencyBenchmarkResult production_al = benchmark_age_latency (ComputeAgeLatency, sample_count, iter_count, n, m, LETDatasetType::generic_dt, seed);
+	BOOST_CHECK_EQUAL(production_al.iter, serial_al.iter);
+	BOOST_CHECK(std::isnan(production_al.checked_time));
+	BOOST_CHECK(std::isnan(production_al.gap_time));
+	BOOST_CHECK(std::isnan(production_al.warm_saved_iter));
 }
 
 
@@ -0,0 +1,86 @@
+/*
+ * BlockReplicationTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE BlockReplicationTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+BOOST_AUTO_TEST_SUITE(BlockReplicationTest)
+
+BOOST_AUTO_TEST_CASE(test_block_expansion) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			for (auto K : {generate_random_periodicity_vector(model, 123 + it), generate_random_ni_periodicity_vector(model, 123 + it)}) {
+
+				InstrumentationCounters::local().algorithm2.clear();
+				auto reference = opt_new_generate_partial_constraint_graph(model, K);
+				const Algorithm2_statistics expected = InstrumentationCounters::local().algorithm2;
+
+				InstrumentationCounters::local().algorithm2.clear();
+				BOOST_REQUIRE_EQUAL(block_generate_compact_constraint_graph(model, K), reference);
+
+				// The block is expanded by Algorithm 2, in the same case as the whole grid.
+				const Algorithm2_statistics& stats = InstrumentationCounters::local().algorithm2;
+				BOOST_CHECK_EQUAL(stats.total_case1, expected.total_case1);
+				BOOST_CHECK_EQUAL(stats.total_case2, expected.total_case2);
+				BOOST_CHECK_EQUAL(stats.total_case3, expected.total_case3);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_block_shape) {
+
+	// Ti = 10, Tj = 15, K = (3, 2): gcdK = 30, the block is the whole 3 x 2 grid.
+	LETModel model;
+	auto t0 = model.addTask(0, 10, 10);
+	auto t1 = model.addTask(0, 15, 15);
+	auto did = model.addDependency(t0, t1);
+	const ModelAnalysisContext context (model);
+
+	const ConstraintBlock whole (context.getKernel(did, {3, 2}));
+	BOOST_CHECK_EQUAL(whole.rows, 3);
+	BOOST_CHECK_EQUAL(whole.columns, 2);
+	BOOST_CHECK_EQUAL(whole.size(), 6);
+
+	// K = (6, 4): gcdK = 60, periods are the whole grid but rows 4..6 are rows 1..3 rotated by 2.
+	const ConstraintBlock lattice (context.getKernel(did, {6, 4}));
+	BOOST_CHECK_EQUAL(lattice.rows, 6);
+	BOOST_CHECK_EQUAL(lattice.columns, 4);
+	BOOST_CHECK_EQUAL(lattice.lattice_rows, 3);
+	BOOST_CHECK_EQUAL(lattice.lattice_columns, 2);
+	BOOST_CHECK_EQUAL(lattice.size(), 12);
+
+	// K = (6, 2): gcdK = 30, the 3 x 2 block is repeated twice along ai.
+	const ConstraintBlock tiled (context.getKernel(did, {6, 2}));
+	BOOST_CHECK_EQUAL(tiled.rows, 3);
+	BOOST_CHECK_EQUAL(tiled.columns, 2);
+	BOOST_CHECK_EQUAL(tiled.size(), 6);
+
+	for (PeriodicityVector K : {PeriodicityVector({3, 2}), PeriodicityVector({6, 4}), PeriodicityVector({6, 2}), PeriodicityVector({12, 8})}) {
+		BOOST_REQUIRE_EQUAL(block_generate_compact_constraint_graph(model, K), generate_partial_constraint_graph(model, K));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_large_k) {
+
+	// K = N, the case the replication is meant for.
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 5, 5, 123 + it);
+			const ModelAnalysisContext context (model);
+			PeriodicityVector K (model.getTaskCount());
+			for (const Task& t : model.tasks()) K[t.getId()] = context.getN(t.getId());
+			BOOST_REQUIRE_EQUAL(block_generate_compact_constraint_graph(model, K), generate_compact_constraint_graph(model, K));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/*
+ * BoundGapTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE BoundGapTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+BOOST_AUTO_TEST_SUITE(BoundGapTest)
+
+BOOST_AUTO_TEST_CASE(test_stop_on_bound_gap) {
+
+	AgeLatencyOptions gap_options;
+	gap_options.stop_on_bound_gap = true;
+
+	size_t closed = 0;
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto reference = ComputeAgeLatency(model, generate_partial_constraint_graph, AgeLatencyOptions::checked());
+			auto gap = ComputeAgeLatency(model, generate_partial_constraint_graph, gap_options);
+
+			BOOST_CHECK_EQUAL(gap.age_latency, reference.age_latency);
+			BOOST_CHECK_LE(gap.iterations, reference.iterations);
+			BOOST_CHECK_LE(gap.best_lower_bound, gap.age_latency);
+			BOOST_CHECK_EQUAL(gap.lower_bounds.size(), gap.iterations);
+			BOOST_CHECK(not reference.closed_by_bounds);
+			if (gap.closed_by_bounds) {
+				BOOST_CHECK_EQUAL(gap.best_lower_bound, gap.age_latency);
+				closed++;
+			}
+		}
+	}
+	BOOST_TEST_MESSAGE("Closed by bounds: " << closed);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_bounds) {
+
+	AgeLatencyOptions concurrent;
+	concurrent.stop_on_bound_gap = true;
+	AgeLatencyOptions sequential = concurrent;
+	sequential.concurrent_bounds = false;
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 456 + it);
+		size_t before = utils::allocation_count();
+		auto c = ComputeAgeLatency(model, generate_partial_constraint_graph, concurrent);
+		const size_t c_allocations = utils::allocation_count() - before;
+		before = utils::allocation_count();
+		auto s = ComputeAgeLatency(model, generate_partial_constraint_graph, sequential);
+		const size_t s_allocations = utils::allocation_count() - before;
+
+		// The work of the lower bound thread is counted as if it ran on the calling thread.
+		BOOST_CHECK_EQUAL(c_allocations, s_allocations);
+		BOOST_CHECK_EQUAL(c.instrumentation.algorithm2.total_case1, s.instrumentation.algorithm2.total_case1);
+		BOOST_CHECK_EQUAL(c.instrumentation.case_edges[2], s.instrumentation.case_edges[2]);
+		BOOST_CHECK_EQUAL(c.instrumentation.dependency_time.size(), s.instrumentation.dependency_time.size());
+
+		BOOST_CHECK_EQUAL(c.age_latency, s.age_latency);
+		BOOST_CHECK_EQUAL(c.iterations, s.iterations);
+		BOOST_CHECK_EQUAL(c.best_lower_bound, s.best_lower_bound);
+		BOOST_CHECK(c.lower_bounds == s.lower_bounds);
+		BOOST_CHECK(c.upper_bounds == s.upper_bounds);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
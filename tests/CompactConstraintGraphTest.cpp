@@ -0,0 +1,137 @@
+/*
+ * CompactConstraintGraphTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE CompactConstraintGraphTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+BOOST_AUTO_TEST_SUITE(CompactConstraintGraphTest)
+
+BOOST_AUTO_TEST_CASE(test_compact_figure2) {
+
+	LETModel figure2;
+
+	TASK_ID t1 = figure2.addTask(0, 1, 2);
+	TASK_ID t2 = figure2.addTask(1, 0.5, 1);
+	TASK_ID t3 = figure2.addTask(2, 4, 6);
+	TASK_ID t4 = figure2.addTask(3, 3, 3);
+
+	figure2.addDependency(t1, t2);
+	figure2.addDependency(t2, t4);
+	figure2.addDependency(t1, t3);
+	figure2.addDependency(t3, t4);
+	figure2.addDependency(t2, t3);
+
+	PeriodicityVector K = {2, 4, 1, 2};
+	auto reference = generate_partial_constraint_graph(figure2, K);
+	auto compact   = generate_compact_constraint_graph(figure2, K);
+
+	BOOST_REQUIRE_EQUAL(compact, reference);
+	BOOST_CHECK_EQUAL(compact.getExecutionCount(), reference.getExecutions().size());
+	BOOST_CHECK_EQUAL(compact.getConstraintCount(), reference.getConstraints().size());
+
+	for (Execution e : reference.getExecutions()) {
+		auto inputs = compact.getInputs(e);
+		auto outputs = compact.getOutputs(e);
+		BOOST_CHECK_EQUAL(inputs.size(), reference.getInputs(e).size());
+		BOOST_CHECK_EQUAL(outputs.size(), reference.getOutputs(e).size());
+		BOOST_CHECK(std::equal(inputs.begin(), inputs.end(), reference.getInputs(e).begin()));
+		BOOST_CHECK(std::equal(outputs.begin(), outputs.end(), reference.getOutputs(e).begin()));
+		BOOST_CHECK_EQUAL(compact.getExecution(compact.getExecutionId(e)), e);
+	}
+
+	BOOST_CHECK_EQUAL(topologicalOrder(compact), topologicalOrder(reference));
+	BOOST_CHECK_EQUAL(FindLongestPath(compact), FindLongestPath(reference));
+}
+
+BOOST_AUTO_TEST_CASE(test_compact_random) {
+
+	for (size_t it = 0 ; it < 20 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+
+			auto reference = generate_partial_constraint_graph(model, K);
+			auto compact   = generate_compact_constraint_graph(model, K);
+			BOOST_REQUIRE_EQUAL(compact, reference);
+
+			auto ref_path = FindLongestPath(reference);
+			auto compact_path = FindLongestPath(compact);
+			BOOST_REQUIRE_EQUAL(compact_path.second, ref_path.second);
+			BOOST_REQUIRE_EQUAL(compact_path.first, ref_path.first);
+
+			BOOST_CHECK_LT(compact.memory_footprint(), reference.memory_footprint());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_compact_duplicated_constraints) {
+
+	LETModel model;
+	auto t0 = model.addTask(0, 5);
+	auto t1 = model.addTask(1, 2);
+	model.addDependency(t0, t1);
+	model.addDependency(t0, t1);
+
+	auto K = generate_periodicity_vector(model, 3);
+	auto reference = generate_partial_constraint_graph(model, K);
+	auto compact   = generate_compact_constraint_graph(model, K);
+	BOOST_REQUIRE_EQUAL(compact, reference);
+}
+
+BOOST_AUTO_TEST_CASE(test_task_levels) {
+
+	LETModel model;
+	auto t0 = model.addTask(0, 4);
+	auto t1 = model.addTask(1, 6);
+	auto t2 = model.addTask(0, 3);
+	auto t3 = model.addTask(0, 2);
+	model.addDependency(t2, t1);
+	model.addDependency(t1, t0);
+	model.addDependency(t2, t0);
+
+	TaskLevels levels = computeTaskLevels(model);
+	BOOST_REQUIRE_EQUAL(levels.size(), 3);
+	BOOST_CHECK(levels[0] == std::vector<TASK_ID>({t2, t3}));
+	BOOST_CHECK(levels[1] == std::vector<TASK_ID>({t1}));
+	BOOST_CHECK(levels[2] == std::vector<TASK_ID>({t0}));
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_longest_path) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+			auto compact = generate_compact_constraint_graph(model, K);
+			auto levels = computeTaskLevels(model);
+
+			auto expected = FindLongestPath(compact);
+			auto single = ParallelFindLongestPath(compact, levels, 1);
+			BOOST_REQUIRE_EQUAL(single.second, expected.second);
+
+			// The path is a path of the graph with the expected length.
+			WEIGHT length = 0;
+			for (size_t i = 0 ; i + 1 < single.first.size() ; i++) {
+				WEIGHT best = std::numeric_limits<WEIGHT>::min();
+				for (Constraint c : compact.getOutputs(single.first[i])) {
+					if (c.getDestination() == single.first[i + 1]) best = std::max(best, c.getWeight());
+				}
+				BOOST_REQUIRE_NE(best, std::numeric_limits<WEIGHT>::min());
+				length += best;
+			}
+			BOOST_CHECK_EQUAL(length, expected.second);
+
+			for (size_t thread_count : {2, 3, 8}) {
+				BOOST_CHECK_EQUAL(ParallelFindLongestPath(compact, levels, thread_count), single);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/*
+ * ConstraintPatternCacheTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE ConstraintPatternCacheTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+BOOST_AUTO_TEST_SUITE(ConstraintPatternCacheTest)
+
+BOOST_AUTO_TEST_CASE(test_cached_expansion) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+
+			InstrumentationCounters::local().clear();
+			auto reference = opt_new_generate_partial_constraint_graph(model, K);
+			const InstrumentationCounters expected = InstrumentationCounters::local();
+
+			InstrumentationCounters::local().clear();
+			BOOST_REQUIRE_EQUAL(cached_generate_partial_constraint_graph(model, K), reference);
+
+			// Hits replay every counter of Algorithm 2, not only the cases.
+			const InstrumentationCounters& stats = InstrumentationCounters::local();
+			BOOST_CHECK_EQUAL(stats.algorithm2.total_case1, expected.algorithm2.total_case1);
+			BOOST_CHECK_EQUAL(stats.algorithm2.total_case2, expected.algorithm2.total_case2);
+			BOOST_CHECK_EQUAL(stats.algorithm2.total_case3, expected.algorithm2.total_case3);
+			for (size_t c = 0 ; c < 3 ; c++) BOOST_CHECK_EQUAL(stats.case_edges[c], expected.case_edges[c]);
+			BOOST_CHECK_EQUAL(stats.theta_scanned, expected.theta_scanned);
+			BOOST_CHECK_EQUAL(stats.theta_kept, expected.theta_kept);
+
+
+#if LETITGO_INSTRUMENTATION
+			const PatternCache_statistics& cache = stats.pattern_cache;
+			BOOST_CHECK_EQUAL(cache.lookups, model.getDependencyCount());
+			BOOST_CHECK_EQUAL(cache.lookups, cache.hits + cache.patterns);
+			BOOST_CHECK_GT(cache.bytes, 0);
+#else
+			BOOST_CHECK_EQUAL(stats.pattern_cache.lookups, 0);
+#endif
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_patterns) {
+
+	// Three dependencies with the same (Ti, Tj, ri - rj, Di), the last one has both offsets shifted.
+	LETModel model;
+	auto t0 = model.addTask(0, 10, 10);
+	auto t1 = model.addTask(0, 15, 15);
+	auto t2 = model.addTask(0, 10, 10);
+	auto t3 = model.addTask(0, 15, 15);
+	auto t4 = model.addTask(5, 10, 10);
+	auto t5 = model.addTask(5, 15, 15);
+	model.addDependency(t0, t1);
+	model.addDependency(t2, t3);
+	model.addDependency(t4, t5);
+	PeriodicityVector K = {3, 2, 3, 2, 3, 2};
+
+	ConstraintPatternCache cache;
+	BOOST_REQUIRE_EQUAL(generate_partial_constraint_graph_with_cache(model, K, cache), generate_partial_constraint_graph(model, K));
+	BOOST_CHECK_EQUAL(cache.getStatistics().lookups, 3);
+	BOOST_CHECK_EQUAL(cache.getStatistics().hits, 2);
+	BOOST_CHECK_EQUAL(cache.getStatistics().patterns, 1);
+
+	// Nothing is stored without room, the graph is the same.
+	ConstraintPatternCache full (1);
+	BOOST_REQUIRE_EQUAL(generate_partial_constraint_graph_with_cache(model, K, full), generate_partial_constraint_graph(model, K));
+	BOOST_CHECK_EQUAL(full.getStatistics().hits, 0);
+	BOOST_CHECK_EQUAL(full.getStatistics().bytes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_cache_across_iterations) {
+
+	auto cache = std::make_shared<ConstraintPatternCache>();
+	PatternCache_statistics reported;
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto reference = ComputeAgeLatency(model);
+			auto cached = ComputeAgeLatency(model, pattern_cache_expansion(cache), AgeLatencyOptions::checked());
+			BOOST_CHECK_EQUAL(cached.age_latency, reference.age_latency);
+			BOOST_CHECK(cached.upper_bounds == reference.upper_bounds);
+			reported += cached.instrumentation.pattern_cache;
+		}
+	}
+	BOOST_CHECK_GT(cache->getStatistics().hits, 0);
+
+#if LETITGO_INSTRUMENTATION
+	// Each analysis reports the lookups of its own expansions.
+	BOOST_CHECK_EQUAL(reported.lookups, cache->getStatistics().lookups);
+	BOOST_CHECK_EQUAL(reported.hits, cache->getStatistics().hits);
+	BOOST_CHECK_EQUAL(reported.bytes, cache->getStatistics().bytes);
+#else
+	BOOST_CHECK_EQUAL(reported.lookups, 0);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_cache_speculative_threads) {
+
+	// Candidates evaluated in parallel share the cache, expansions take turns.
+	AgeLatencyOptions parallel = AgeLatencyOptions::checked();
+	parallel.refinement = speculative_refinement({critical_path_refinement(), neighbourhood_refinement(), small_n_refinement(4)});
+	parallel.speculative_threads = 4;
+
+	auto cache = std::make_shared<ConstraintPatternCache>();
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 456 + it);
+		auto reference = ComputeAgeLatency(model, generate_partial_constraint_graph, parallel);
+		auto cached = ComputeAgeLatency(model, pattern_cache_expansion(cache), parallel);
+		BOOST_CHECK_EQUAL(cached.age_latency, reference.age_latency);
+		BOOST_CHECK(cached.upper_bounds == reference.upper_bounds);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
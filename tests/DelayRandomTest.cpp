@@ -14,9 +14,29 @@ BOOST_AUTO_TEST_CASE(test_random_615623606) {
 	  size_t m = 5;
 	  size_t seed = 615623606;
 	  LETModel sample = generate_Automotive_LET(n,m,seed);
-	  auto delay = ComputeAgeLatency(sample);
+	  auto delay = ComputeAgeLatency(sample, generate_partial_constraint_graph, AgeLatencyOptions::checked());
 	  BOOST_CHECK_GT(delay.age_latency, 0);
 }
 
+BOOST_AUTO_TEST_CASE(test_production_options) {
+	for (size_t seed = 1 ; seed <= 10 ; seed++) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel sample = Generator::getInstance().generate(dt, 8, 12, seed);
+			auto checked = ComputeAgeLatency(sample, generate_partial_constraint_graph, AgeLatencyOptions::checked());
+			auto production = ComputeAgeLatency(sample);
+			BOOST_CHECK_EQUAL(production.age_latency, checked.age_latency);
+			BOOST_CHECK_EQUAL(production.iterations, checked.iterations);
+			BOOST_CHECK_EQUAL(production.upper_bounds.size(), production.iterations);
+			BOOST_CHECK_EQUAL(checked.lower_bounds.size(), checked.iterations);
+			BOOST_CHECK(production.lower_bounds.empty());
+
+			AgeLatencyOptions quiet;
+			quiet.collect_statistics = false;
+			auto minimal = ComputeAgeLatency(sample, generate_partial_constraint_graph, quiet);
+			BOOST_CHECK_EQUAL(minimal.age_latency, checked.age_latency);
+			BOOST_CHECK(minimal.upper_bounds.empty());
+		}
+	}
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,64 @@
+/*
+ * EngineTestHelpers.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#ifndef TESTS_ENGINETESTHELPERS_H_
+#define TESTS_ENGINETESTHELPERS_H_
+
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <limits>
+
+/**
+ * Check the path found by engine is a path of the reference expansion
+ * and that it is as long as the one found by FindLongestPath.
+ */
+inline CriticalPathResult check_engine_against_reference (AgeLatencyEngineFun engine, const LETModel& model, const PeriodicityVector& K) {
+	auto reference = generate_partial_constraint_graph(model, K);
+	auto expected = FindLongestPath(reference);
+	auto res = engine(ModelAnalysisContext(model), K);
+
+	BOOST_REQUIRE_EQUAL(res.length, expected.second);
+	BOOST_REQUIRE_GE(res.edge_count, reference.getConstraints().size());
+
+	BOOST_REQUIRE_GE(res.path.size(), 3);
+	BOOST_CHECK_EQUAL(res.path.front(), Execution(-1, 0));
+	BOOST_CHECK_EQUAL(res.path.back(), Execution(-1, 1));
+	WEIGHT length = 0;
+	for (size_t i = 0 ; i + 1 < res.path.size() ; i++) {
+		WEIGHT best = std::numeric_limits<WEIGHT>::min();
+		for (const Constraint& c : reference.getOutputs(res.path[i])) {
+			if (c.getDestination() == res.path[i + 1]) best = std::max(best, c.getWeight());
+		}
+		BOOST_REQUIRE_NE(best, std::numeric_limits<WEIGHT>::min());
+		length += best;
+	}
+	BOOST_CHECK_EQUAL(length, res.length);
+	return res;
+}
+
+/**
+ * Same check on a model whose dependencies go from higher to lower task ids,
+ * engines that visit tasks in id order get it wrong.
+ */
+inline void check_engine_non_topological_ids (AgeLatencyEngineFun engine) {
+	LETModel model;
+	auto t0 = model.addTask(0, 4);
+	auto t1 = model.addTask(1, 6);
+	auto t2 = model.addTask(0, 3);
+	model.addDependency(t2, t1);
+	model.addDependency(t1, t0);
+	model.addDependency(t2, t0);
+
+	check_engine_against_reference(engine, model, {2, 1, 4});
+	check_engine_against_reference(engine, model, {3, 2, 4});
+
+	auto reference = ComputeAgeLatency(model);
+	auto res = ComputeAgeLatencyWithEngine(model, engine, AgeLatencyOptions::checked());
+	BOOST_CHECK_EQUAL(res.age_latency, reference.age_latency);
+}
+
+#endif /* TESTS_ENGINETESTHELPERS_H_ */
@@ -373,11 +373,11 @@ BOOST_AUTO_TEST_CASE(test_rosace_fast_graph) {
   rosace->addDependency(t5, t3);
   rosace->addDependency(t6, t4);
 
-  auto delay = ComputeAgeLatency(*rosace, new_generate_partial_constraint_graph);
+  auto delay = ComputeAgeLatency(*rosace, new_generate_partial_constraint_graph, AgeLatencyOptions::checked());
   BOOST_REQUIRE_EQUAL(delay.age_latency , 240);
 
 
-  delay = ComputeAgeLatency(*rosace, opt_new_generate_partial_constraint_graph);
+  delay = ComputeAgeLatency(*rosace, opt_new_generate_partial_constraint_graph, AgeLatencyOptions::checked());
   BOOST_REQUIRE_EQUAL(delay.age_latency , 240);
 
 }
@@ -414,4 +414,30 @@ BOOST_AUTO_TEST_CASE(test_fast_graph_random) {
 
 
 
+BOOST_AUTO_TEST_CASE(test_fast_graph_case2_case3_enumeration) {
+
+	// Exhaustive pairs of tasks, so that case 3 meets both fewer and more theta than aj.
+	InstrumentationCounters::local().algorithm2.clear();
+	for (INTEGER_TIME_UNIT Ti : {2, 3, 4, 6, 10, 15}) {
+		for (INTEGER_TIME_UNIT Tj : {2, 3, 4, 6, 10, 15}) {
+			for (TIME_UNIT rj : {0, 3}) {
+				for (EXECUTION_COUNT Ki : {1, 2, 5, 7}) {
+					for (EXECUTION_COUNT Kj : {1, 2, 5, 7}) {
+						LETModel model;
+						auto t0 = model.addTask(1, Ti);
+						auto t1 = model.addTask(rj, Tj);
+						model.addDependency(t0, t1);
+						PeriodicityVector K = {Ki, Kj};
+						BOOST_REQUIRE_EQUAL(opt_new_generate_partial_constraint_graph(model, K), generate_partial_constraint_graph(model, K));
+					}
+				}
+			}
+		}
+	}
+#if LETITGO_INSTRUMENTATION
+	BOOST_CHECK_GT(InstrumentationCounters::local().algorithm2.total_case2, 0);
+	BOOST_CHECK_GT(InstrumentationCounters::local().algorithm2.total_case3, 0);
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -55,7 +55,7 @@ BOOST_AUTO_TEST_CASE(test_figure2_graph) {
 	std::cout << "LongestPath: " << L << std::endl;
 
 	std::cout << "Start ComputeAgeLatency" << std::endl;
-	auto delay = ComputeAgeLatency(*figure2);
+	auto delay = ComputeAgeLatency(*figure2, generate_partial_constraint_graph, AgeLatencyOptions::checked());
 
 	BOOST_CHECK_EQUAL(delay.age_latency, 12);
 }
@@ -87,7 +87,7 @@ BOOST_AUTO_TEST_CASE(test_rosace_delay) {
 	rosace->addDependency(t5, t3);
 	rosace->addDependency(t6, t4);
 
-	auto delay = ComputeAgeLatency(*rosace);
+	auto delay = ComputeAgeLatency(*rosace, generate_partial_constraint_graph, AgeLatencyOptions::checked());
 	INTEGER_TIME_UNIT sum_n = getSumN<INTEGER_TIME_UNIT> (*rosace);
 	std::cout << "sum_n=" << sum_n << std::endl;
 	std::cout << delay << std::endl;
@@ -0,0 +1,68 @@
+/*
+ * FusedExpansionTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE FusedExpansionTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include "EngineTestHelpers.h"
+
+/**
+ * The fused engine also visits every execution of the reference expansion.
+ */
+static void check_fused_against_reference (const LETModel& model, const PeriodicityVector& K) {
+	auto fused = check_engine_against_reference(fused_expansion_engine, model, K);
+	BOOST_CHECK_EQUAL(fused.vertex_count, generate_partial_constraint_graph(model, K).getExecutions().size());
+}
+
+BOOST_AUTO_TEST_SUITE(FusedExpansionTest)
+
+BOOST_AUTO_TEST_CASE(test_fused_figure2) {
+
+	LETModel figure2;
+
+	TASK_ID t1 = figure2.addTask(0, 1, 2);
+	TASK_ID t2 = figure2.addTask(1, 0.5, 1);
+	TASK_ID t3 = figure2.addTask(2, 4, 6);
+	TASK_ID t4 = figure2.addTask(3, 3, 3);
+
+	figure2.addDependency(t1, t2);
+	figure2.addDependency(t2, t4);
+	figure2.addDependency(t1, t3);
+	figure2.addDependency(t3, t4);
+	figure2.addDependency(t2, t3);
+
+	check_fused_against_reference(figure2, {1, 1, 1, 1});
+	check_fused_against_reference(figure2, {2, 4, 1, 2});
+
+	auto reference = ComputeAgeLatency(figure2);
+	auto fused = ComputeAgeLatencyWithEngine(figure2, fused_expansion_engine, AgeLatencyOptions::checked());
+	BOOST_CHECK_EQUAL(fused.age_latency, reference.age_latency);
+}
+
+BOOST_AUTO_TEST_CASE(test_fused_random) {
+
+	for (size_t it = 0 ; it < 20 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			check_fused_against_reference(model, generate_periodicity_vector(model));
+			check_fused_against_reference(model, generate_random_periodicity_vector(model, 123 + it));
+
+			auto reference = ComputeAgeLatency(model);
+			auto fused = ComputeAgeLatencyWithEngine(model, fused_expansion_engine, AgeLatencyOptions::checked());
+			BOOST_CHECK_EQUAL(fused.age_latency, reference.age_latency);
+			BOOST_CHECK_EQUAL(fused.upper_bounds.front(), reference.upper_bounds.front());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fused_non_topological_ids) {
+
+	check_engine_non_topological_ids(fused_expansion_engine);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
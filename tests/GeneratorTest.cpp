@@ -247,7 +247,7 @@ BOOST_AUTO_TEST_CASE(test_fix2) {
 	INTEGER_TIME_UNIT lcm = getLCM<INTEGER_TIME_UNIT>(sample);
 	std::cout << "LCM=" << lcm << std::endl;
 
-	ComputeAgeLatency(sample, generate_partial_constraint_graph);
+	ComputeAgeLatency(sample, generate_partial_constraint_graph, AgeLatencyOptions::checked());
 
 
 }
@@ -0,0 +1,103 @@
+/*
+ * GraphReductionTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE GraphReductionTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+/**
+ * The reduced graph keeps the bound of FindLongestPath and its path, once expanded,
+ * is a path of the original graph of the same length.
+ */
+static void check_reduction (const LETModel& model, const PeriodicityVector& K, const GraphReductionOptions& options) {
+	auto original = generate_compact_constraint_graph(model, K);
+	auto expected = FindLongestPath(original);
+	auto reduced = reduce_constraint_graph(model, K, original, options);
+	auto found = FindLongestPath(reduced);
+
+	BOOST_REQUIRE_EQUAL(found.second, expected.second);
+	BOOST_CHECK_LE(reduced.graph.getConstraintCount(), original.getConstraintCount());
+
+	BOOST_REQUIRE_GE(found.first.size(), 3);
+	BOOST_CHECK_EQUAL(found.first.front(), Execution(-1, 0));
+	BOOST_CHECK_EQUAL(found.first.back(), Execution(-1, 1));
+	WEIGHT length = 0;
+	for (size_t i = 0 ; i + 1 < found.first.size() ; i++) {
+		WEIGHT best = std::numeric_limits<WEIGHT>::min();
+		for (const Constraint& c : original.getOutputs(found.first[i])) {
+			if (c.getDestination() == found.first[i + 1]) best = std::max(best, c.getWeight());
+		}
+		BOOST_REQUIRE_NE(best, std::numeric_limits<WEIGHT>::min());
+		length += best;
+	}
+	BOOST_CHECK_EQUAL(length, found.second);
+}
+
+BOOST_AUTO_TEST_SUITE(GraphReductionTest)
+
+BOOST_AUTO_TEST_CASE(test_reduction_random) {
+
+	GraphReductionOptions dominated_only, series_only;
+	dominated_only.series = false;
+	series_only.dominated = false;
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			for (auto K : {generate_periodicity_vector(model), generate_random_periodicity_vector(model, 123 + it)}) {
+				check_reduction(model, K, GraphReductionOptions());
+				check_reduction(model, K, dominated_only);
+				check_reduction(model, K, series_only);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_reduction_small) {
+
+	// s -> a -> b -> f is a chain, a -> c is dominated by a -> b -> c.
+	LETModel model;
+	auto t0 = model.addTask(0, 10);
+	auto t1 = model.addTask(0, 10);
+	auto t2 = model.addTask(0, 10);
+	model.addDependency(t0, t1);
+	model.addDependency(t1, t2);
+	model.addDependency(t0, t2);
+	const PeriodicityVector K = {1, 1, 1};
+
+	auto original = generate_compact_constraint_graph(model, K);
+	BOOST_REQUIRE_EQUAL(original.getConstraintCount(), 5);
+	auto reduced = reduce_constraint_graph(model, K, original);
+	BOOST_CHECK_EQUAL(reduced.dominated_count, 1);
+	BOOST_CHECK_EQUAL(reduced.contracted_count, 3);
+	BOOST_CHECK_EQUAL(reduced.graph.getConstraintCount(), 1);
+
+	auto found = FindLongestPath(reduced);
+	auto expected = FindLongestPath(original);
+	BOOST_CHECK_EQUAL(found.second, expected.second);
+	BOOST_CHECK(found.first == expected.first);
+}
+
+BOOST_AUTO_TEST_CASE(test_reduced_engine) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			auto reference = ComputeAgeLatency(model);
+			auto reduced = ComputeAgeLatencyWithEngine(model, reduced_expansion_engine(), AgeLatencyOptions::checked());
+			BOOST_CHECK_EQUAL(reduced.age_latency, reference.age_latency);
+			BOOST_CHECK_EQUAL(reduced.upper_bounds.front(), reference.upper_bounds.front());
+			BOOST_REQUIRE_EQUAL(reduced.reduced_edge_count.size(), reduced.iterations);
+			BOOST_CHECK_LE(reduced.reduction_ratio(), 1.0);
+			BOOST_CHECK_GE(reduced.reduction_time, 0);
+		}
+	}
+	BOOST_CHECK_EQUAL(ComputeAgeLatency(Generator::getInstance().generate(LETDatasetType::automotive_dt, 8, 12, 123)).reduction_ratio(), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/*
+ * IncrementalExpansionTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE IncrementalExpansionTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+BOOST_AUTO_TEST_SUITE(IncrementalExpansionTest)
+
+BOOST_AUTO_TEST_CASE(test_remove) {
+
+	LETModel model;
+	auto t0 = model.addTask(0, 5);
+	auto t1 = model.addTask(1, 2);
+	model.addDependency(t0, t1);
+
+	auto K = generate_periodicity_vector(model, 3);
+	PartialConstraintGraph graph = generate_partial_constraint_graph(model, K);
+	const PartialConstraintGraph reference = graph;
+
+	Constraint extra (Execution(t0, 1), Execution(t1, 1), 1000);
+	graph.add(extra);
+	BOOST_CHECK_NE(graph, reference);
+	graph.remove(extra);
+	BOOST_CHECK_EQUAL(graph, reference);
+
+	// Removing an absent constraint is a no-op.
+	graph.remove(extra);
+	BOOST_CHECK_EQUAL(graph, reference);
+
+	// Removing everything also removes the executions.
+	std::vector<Constraint> all (reference.getConstraints().begin(), reference.getConstraints().end());
+	for (const Constraint& c : all) graph.remove(c);
+	BOOST_CHECK_EQUAL(graph.getConstraints().size(), 0);
+	BOOST_CHECK_EQUAL(graph.getExecutions().size(), 0);
+	BOOST_CHECK_EQUAL(graph.inbounds.size(), 0);
+	BOOST_CHECK_EQUAL(graph.outbounds.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_updates) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			model.addDependency(model.dependencies()[0].getFirst(), model.dependencies()[0].getSecond());
+
+			// Grow K one task at a time and check the graph against a full expansion.
+			AgeLatencyEngineFun engine = incremental_expansion_engine();
+			PeriodicityVector K = generate_periodicity_vector(model);
+			const ModelAnalysisContext context (model);
+			auto res = engine(context, K);
+			BOOST_CHECK_EQUAL(res.reused_dependencies, 0);
+			for (size_t tid = 0 ; tid < model.getTaskCount() ; tid++) {
+				K[tid] = K[tid] * 2;
+				res = engine(context, K);
+				auto reference = generate_partial_constraint_graph(model, K);
+				auto expected = FindLongestPath(reference);
+				BOOST_REQUIRE_EQUAL(res.length, expected.second);
+				BOOST_REQUIRE_EQUAL(res.path, expected.first);
+				BOOST_REQUIRE_EQUAL(res.vertex_count, reference.getExecutions().size());
+				BOOST_REQUIRE_EQUAL(res.edge_count, reference.getConstraints().size());
+
+				size_t expected_reused = 0;
+				for (const Dependency& d : model.dependencies()) {
+					if (d.getFirst() != (TASK_ID) tid and d.getSecond() != (TASK_ID) tid) expected_reused++;
+				}
+				BOOST_CHECK_EQUAL(res.reused_dependencies, expected_reused);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_age_latency) {
+
+	AgeLatencyEngineFun shared = incremental_expansion_engine();
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+
+			auto reference = ComputeAgeLatency(model);
+			auto incremental = ComputeAgeLatencyWithEngine(model, incremental_expansion_engine(), AgeLatencyOptions::checked());
+			BOOST_CHECK_EQUAL(incremental.age_latency, reference.age_latency);
+			BOOST_CHECK(incremental.upper_bounds == reference.upper_bounds);
+			BOOST_CHECK(incremental.expansion_edge_count == reference.expansion_edge_count);
+			BOOST_REQUIRE_EQUAL(incremental.reused_dependency_count.size(), incremental.upper_bounds.size());
+			BOOST_CHECK_EQUAL(incremental.reused_dependency_count.front(), 0);
+
+			// The same engine reused on another model starts over.
+			auto again = ComputeAgeLatencyWithEngine(model, shared, AgeLatencyOptions::checked());
+			BOOST_CHECK(again.upper_bounds == reference.upper_bounds);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_speculative_threads) {
+
+	// Candidates evaluated in parallel share the state of the engine, calls take turns.
+	AgeLatencyOptions sequential;
+	sequential.refinement = speculative_refinement({critical_path_refinement(), neighbourhood_refinement(), small_n_refinement(4)});
+	AgeLatencyOptions parallel = sequential;
+	parallel.speculative_threads = 4;
+
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 456 + it);
+		auto reference = ComputeAgeLatencyWithEngine(model, incremental_expansion_engine(), sequential);
+		auto threaded = ComputeAgeLatencyWithEngine(model, incremental_expansion_engine(), parallel);
+		BOOST_CHECK_EQUAL(threaded.age_latency, reference.age_latency);
+		BOOST_CHECK(threaded.upper_bounds == reference.upper_bounds);
+		BOOST_CHECK(threaded.expansion_edge_count == reference.expansion_edge_count);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
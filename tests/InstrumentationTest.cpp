@@ -0,0 +1,129 @@
+/*
+ * InstrumentationTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE InstrumentationTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include <algorithm2.h>
+
+struct CountingSink {
+	size_t count = 0;
+	inline void add (const Constraint&) { count++; }
+};
+
+BOOST_AUTO_TEST_SUITE(InstrumentationTest)
+
+BOOST_AUTO_TEST_CASE(test_scope_restores_outer_counters) {
+
+	InstrumentationCounters::local().clear();
+	InstrumentationCounters::local().algorithm2.total_case1 = 5;
+	InstrumentationCounters::local().theta_scanned = 7;
+	{
+		InstrumentationScope scope;
+		BOOST_CHECK_EQUAL(scope.collect().algorithm2.total_case1, 0);
+		InstrumentationCounters::local().algorithm2.total_case1 += 2;
+		InstrumentationCounters::local().theta_scanned += 3;
+		BOOST_CHECK_EQUAL(scope.collect().algorithm2.total_case1, 2);
+		BOOST_CHECK_EQUAL(scope.collect().theta_scanned, 3);
+	}
+	BOOST_CHECK_EQUAL(InstrumentationCounters::local().algorithm2.total_case1, 7);
+	BOOST_CHECK_EQUAL(InstrumentationCounters::local().theta_scanned, 10);
+	InstrumentationCounters::local().clear();
+}
+
+BOOST_AUTO_TEST_CASE(test_counters_of_algorithm2) {
+
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+			const ModelAnalysisContext context (model);
+
+			InstrumentationScope scope;
+			CountingSink sink;
+			for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) new_algorithm2(context, K, did, sink);
+
+#if LETITGO_INSTRUMENTATION
+			const InstrumentationCounters& counters = scope.collect();
+			const Algorithm2_statistics& stats = counters.algorithm2;
+			BOOST_CHECK_EQUAL(stats.total_case1 + stats.total_case2 + stats.total_case3, context.getDependencyCount());
+			std::vector<size_t> cases (4, 0);
+			for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) cases[algorithm2_case(context.getKernel(did, K))]++;
+			BOOST_CHECK_EQUAL(cases[1], stats.total_case1);
+			BOOST_CHECK_EQUAL(cases[2], stats.total_case2);
+			BOOST_CHECK_EQUAL(cases[3], stats.total_case3);
+			BOOST_CHECK_EQUAL(counters.case_edges[0] + counters.case_edges[1] + counters.case_edges[2], sink.count);
+			BOOST_CHECK_LE(counters.theta_kept, counters.theta_scanned);
+			if (stats.total_case1 == 0) BOOST_CHECK_EQUAL(counters.case_edges[0], 0);
+			if (stats.total_case3 == 0) BOOST_CHECK_EQUAL(counters.theta_scanned, 0);
+#endif
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_counters) {
+
+	for (size_t it = 0 ; it < 5 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+
+			InstrumentationCounters serial;
+			{
+				InstrumentationScope scope;
+				opt_new_generate_partial_constraint_graph(model, K);
+				serial = scope.collect();
+			}
+			for (size_t thread_count : {2, 4}) {
+				InstrumentationScope scope;
+				parallel_expansion(thread_count)(model, K);
+				const InstrumentationCounters& parallel = scope.collect();
+				BOOST_CHECK_EQUAL(parallel.algorithm2.total_case1, serial.algorithm2.total_case1);
+				BOOST_CHECK_EQUAL(parallel.algorithm2.total_case2, serial.algorithm2.total_case2);
+				BOOST_CHECK_EQUAL(parallel.algorithm2.total_case3, serial.algorithm2.total_case3);
+				for (size_t c = 0 ; c < 3 ; c++) BOOST_CHECK_EQUAL(parallel.case_edges[c], serial.case_edges[c]);
+				BOOST_CHECK_EQUAL(parallel.theta_scanned, serial.theta_scanned);
+				BOOST_CHECK_EQUAL(parallel.theta_kept, serial.theta_kept);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_age_latency_counters) {
+
+	std::vector<LETModel> models;
+	for (size_t it = 0 ; it < 4 ; it ++ ) models.push_back(Generator::getInstance().generate(LETDatasetType::harmonic_dt, 10, 20, 123 + it));
+
+	InstrumentationCounters::local().clear();
+	std::vector<AgeLatencyResult> sequential;
+	for (const LETModel& model : models) {
+		sequential.push_back(ComputeAgeLatency(model, opt_new_generate_partial_constraint_graph));
+#if LETITGO_INSTRUMENTATION
+		const InstrumentationCounters& counters = sequential.back().instrumentation;
+		const Algorithm2_statistics& stats = counters.algorithm2;
+		BOOST_CHECK_EQUAL(stats.total_case1 + stats.total_case2 + stats.total_case3, model.getDependencyCount() * sequential.back().iterations);
+		BOOST_CHECK_EQUAL(counters.dependency_time.size(), model.getDependencyCount());
+		BOOST_CHECK(counters.phase_time.count("context_setup"));
+		BOOST_CHECK(counters.phase_time.count("critical_path"));
+#endif
+	}
+
+	// Each analysis has its own counters, whatever thread ran it.
+	const auto batch = ComputeAgeLatencyBatch(models, AgeLatencyOptions(), 3, [] (const LETModel& model, GenerateExpansionFun, const AgeLatencyOptions& options) {
+		return ComputeAgeLatency(model, opt_new_generate_partial_constraint_graph, options);
+	});
+	BOOST_REQUIRE_EQUAL(batch.size(), sequential.size());
+	for (size_t i = 0 ; i < batch.size() ; i++) {
+		BOOST_CHECK_EQUAL(batch[i].instrumentation.algorithm2.total_case1, sequential[i].instrumentation.algorithm2.total_case1);
+		BOOST_CHECK_EQUAL(batch[i].instrumentation.algorithm2.total_case2, sequential[i].instrumentation.algorithm2.total_case2);
+		BOOST_CHECK_EQUAL(batch[i].instrumentation.algorithm2.total_case3, sequential[i].instrumentation.algorithm2.total_case3);
+		for (size_t c = 0 ; c < 3 ; c++) BOOST_CHECK_EQUAL(batch[i].instrumentation.case_edges[c], sequential[i].instrumentation.case_edges[c]);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
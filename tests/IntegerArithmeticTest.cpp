@@ -0,0 +1,119 @@
+/*
+ * IntegerArithmeticTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE IntegerArithmeticTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(IntegerArithmeticTest)
+
+BOOST_AUTO_TEST_CASE(test_floor_ceil_div) {
+
+	for (long a = -50 ; a <= 50 ; a++) {
+		for (long b : {-7L, -3L, -1L, 1L, 2L, 5L, 12L}) {
+			BOOST_CHECK_EQUAL(utils::floor_div(a, b), (long) std::floor((double) a / (double) b));
+			BOOST_CHECK_EQUAL(utils::ceil_div(a, b), (long) std::ceil((double) a / (double) b));
+			const long r = utils::pos_mod(a, b);
+			BOOST_CHECK(0 <= r and r < std::abs(b));
+			BOOST_CHECK_EQUAL((a - r) % b, 0);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_wide_products) {
+
+	// 2^40 * 2^40 does not fit in a long, the quotient does.
+	const long big = 1L << 40;
+	BOOST_CHECK_EQUAL(utils::mul_floor_div(big, big, big), big);
+	BOOST_CHECK_EQUAL(utils::mul_floor_div(big + 1, big - 1, big), big - 1);
+	BOOST_CHECK_EQUAL(utils::mul_ceil_div(big + 1, big - 1, big), big);
+	BOOST_CHECK_EQUAL(utils::mul_floor_div(-big - 1, big - 1, big), -big);
+	BOOST_CHECK_EQUAL(utils::checked_mul(big, 1L << 20), 1L << 60);
+
+	// Beyond 2^53 double can not tell two consecutive values apart.
+	const long huge = (1L << 60) + 1;
+	BOOST_CHECK_EQUAL(utils::ceil_div(huge, 2L), (1L << 59) + 1);
+	BOOST_CHECK_EQUAL(utils::floor_div(-huge, 2L), -(1L << 59) - 1);
+
+	BOOST_CHECK_EQUAL(utils::exact_integer(42.0), 42);
+	BOOST_CHECK_EQUAL(utils::exact_integer(-3.0), -3);
+}
+
+BOOST_AUTO_TEST_CASE(test_theorem6_kernel) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+
+			for (const Dependency& d : model.dependencies()) {
+				const Task ti = model.getTaskById(d.getFirst());
+				const Task tj = model.getTaskById(d.getSecond());
+				const Theorem6Kernel kernel (ti, tj, K[d.getFirst()], K[d.getSecond()]);
+
+				const INTEGER_TIME_UNIT Ti = ti.getT();
+				const INTEGER_TIME_UNIT Tj = tj.getT();
+				const auto Me = Tj + std::ceil((ti.getr() - tj.getr() + ti.getD()) / kernel.gcdT) * kernel.gcdT;
+				BOOST_REQUIRE_EQUAL(kernel.Me, Me);
+
+				for (EXECUTION_COUNT ai = 1 ; ai <= K[d.getFirst()] ; ai++) {
+					for (EXECUTION_COUNT aj = 1 ; aj <= K[d.getSecond()] ; aj++) {
+						const INTEGER_TIME_UNIT alpha = (Ti * ai - Tj * aj) / kernel.gcdT;
+						const INTEGER_TIME_UNIT pi_min = std::ceil((-Me + kernel.gcdT - alpha * kernel.gcdT) / kernel.gcdK);
+						const INTEGER_TIME_UNIT pi_max = std::floor((-Me + Ti - alpha * kernel.gcdT) / kernel.gcdK);
+						const INTEGER_TIME_UNIT alphagcdT = kernel.alphagcdT(ai, aj);
+						BOOST_REQUIRE_EQUAL(kernel.pi_min(alphagcdT), pi_min);
+						BOOST_REQUIRE_EQUAL(kernel.pi_max(alphagcdT), pi_max);
+						BOOST_REQUIRE_EQUAL(kernel.Lmax(alphagcdT), tj.getr() - ti.getr() + Ti - Tj - (pi_min * kernel.gcdK + alpha * kernel.gcdT));
+					}
+				}
+			}
+
+			// Every generator now runs on the integer kernel.
+			auto reference = generate_partial_constraint_graph(model, K);
+			BOOST_REQUIRE_EQUAL(opt_new_generate_partial_constraint_graph(model, K), reference);
+			BOOST_REQUIRE_EQUAL(generate_compact_constraint_graph(model, K), reference);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_theorem6_row) {
+
+	std::vector<RowKernelIsa> isas = {RowKernelIsa::scalar};
+	if (detect_row_kernel_isa() != RowKernelIsa::scalar) isas.push_back(RowKernelIsa::avx2);
+	if (detect_row_kernel_isa() == RowKernelIsa::avx512) isas.push_back(RowKernelIsa::avx512);
+	BOOST_TEST_MESSAGE("Row kernels tested: " << isas);
+
+	LETModel model;
+	auto t0 = model.addTask(3, 7, 12);
+	auto t1 = model.addTask(0, 18);
+	auto t2 = model.addTask(5, 1);
+	auto t3 = model.addTask(0, 1000000007);
+
+	std::vector<std::pair<TASK_ID, TASK_ID>> pairs = {{t0, t1}, {t1, t0}, {t0, t2}, {t2, t1}, {t3, t0}, {t1, t3}};
+	for (auto p : pairs) {
+		// Rows shorter and longer than the vector lanes, with tails.
+		for (EXECUTION_COUNT Ki : {1, 3}) {
+			for (EXECUTION_COUNT Kj : {1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 31, 100}) {
+				const Theorem6Kernel kernel (model.getTaskById(p.first), model.getTaskById(p.second), Ki, Kj);
+				for (EXECUTION_COUNT ai = 1 ; ai <= Ki ; ai++) {
+					std::vector<INTEGER_TIME_UNIT> expected (Kj);
+					for (EXECUTION_COUNT aj = 1 ; aj <= Kj ; aj++) expected[aj - 1] = kernel.Lmax(kernel.alphagcdT(ai, aj));
+					for (RowKernelIsa isa : isas) {
+						std::vector<INTEGER_TIME_UNIT> row (Kj);
+						theorem6_row(kernel, ai, Kj, row.data(), isa);
+						BOOST_REQUIRE(row == expected);
+					}
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
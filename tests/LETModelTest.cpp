@@ -59,4 +59,14 @@ BOOST_AUTO_TEST_CASE(test_dep_from_unknow_task) {
   delete figure1;
 }
 
+BOOST_AUTO_TEST_CASE(test_fractional_release_date) {
+
+	// The expansions compute on integers, the model refuses a fractional release date.
+	LETModel model;
+	BOOST_CHECK_THROW(model.addTask(0.5, 10), std::runtime_error);
+	BOOST_CHECK_EQUAL(model.getTaskCount(), 0);
+	BOOST_CHECK_EQUAL(model.addTask(2, 10), 0);
+	BOOST_CHECK_THROW(shift_task_offset(model, 0, 0.25), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
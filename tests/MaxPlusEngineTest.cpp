@@ -0,0 +1,103 @@
+/*
+ * MaxPlusEngineTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE MaxPlusEngineTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include "EngineTestHelpers.h"
+
+BOOST_AUTO_TEST_SUITE(MaxPlusEngineTest)
+
+BOOST_AUTO_TEST_CASE(test_max_plus_block) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+			auto reference = generate_partial_constraint_graph(model, K);
+
+			// Every finite weight of the blocks is a constraint of the reference and conversely.
+			const ModelAnalysisContext context (model);
+			size_t constraints = 0, counted = 0;
+			for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) context.getDependencyCount() ; did++) {
+				const DependencyConstants& d = context.getDependency(did);
+				const MaxPlusBlock block = make_max_plus_block(context.getKernel(did, K), K[d.ti], K[d.tj]);
+				for (size_t r = 0 ; r < block.rows.size() ; r++) {
+					for (EXECUTION_COUNT c = 0 ; c < block.Kj ; c++) {
+						const WEIGHT w = block.row(r)[c];
+						if (w == MAX_PLUS_NONE) continue;
+						BOOST_CHECK(block.first[r] <= c and c < block.last[r]);
+						const Constraint expected (Execution(d.ti, block.rows[r]), Execution(d.tj, c + 1), w);
+						BOOST_CHECK(reference.getConstraints().count(expected) == 1);
+						constraints++;
+					}
+				}
+				counted += block.constraint_count;
+			}
+			BOOST_CHECK_EQUAL(counted, constraints);
+			BOOST_CHECK_EQUAL(constraints + reference.getOutputs(Execution(-1, 0)).size() + reference.getInputs(Execution(-1, 1)).size(),
+					reference.getConstraints().size());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_max_plus_row_isa) {
+
+	std::vector<RowKernelIsa> isas = {RowKernelIsa::scalar};
+	if (detect_row_kernel_isa() != RowKernelIsa::scalar) isas.push_back(RowKernelIsa::avx2);
+	if (detect_row_kernel_isa() == RowKernelIsa::avx512) isas.push_back(RowKernelIsa::avx512);
+
+	std::vector<WEIGHT> weights, initial;
+	for (size_t k = 0 ; k < 37 ; k++) {
+		weights.push_back((k % 5 == 0) ? MAX_PLUS_NONE : (WEIGHT) (k * 7919 % 31) - 15);
+		initial.push_back((k % 3 == 0) ? MAX_PLUS_NONE : (WEIGHT) (k * 104729 % 23) - 11);
+	}
+
+	std::vector<WEIGHT> expected_dist = initial;
+	std::vector<long> expected_prev (initial.size(), 3);
+	max_plus_row(weights.data(), 4, 42, expected_dist.data(), expected_prev.data(), weights.size(), RowKernelIsa::scalar);
+	for (size_t k = 0 ; k < weights.size() ; k++) {
+		BOOST_CHECK_EQUAL(expected_dist[k], std::max(initial[k], 4 + weights[k]));
+		BOOST_CHECK_EQUAL(expected_prev[k], (4 + weights[k] > initial[k]) ? 42 : 3);
+	}
+
+	for (RowKernelIsa isa : isas) {
+		for (size_t count : {(size_t) 0, (size_t) 3, (size_t) 8, weights.size()}) {
+			std::vector<WEIGHT> dist = initial;
+			std::vector<long> prev (initial.size(), 3);
+			max_plus_row(weights.data(), 4, 42, dist.data(), prev.data(), count, isa);
+			for (size_t k = 0 ; k < weights.size() ; k++) {
+				BOOST_CHECK_EQUAL(dist[k], k < count ? expected_dist[k] : initial[k]);
+				BOOST_CHECK_EQUAL(prev[k], k < count ? expected_prev[k] : 3);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_max_plus_random) {
+
+	for (size_t it = 0 ; it < 20 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			check_engine_against_reference(max_plus_engine, model, generate_periodicity_vector(model));
+			check_engine_against_reference(max_plus_engine, model, generate_random_periodicity_vector(model, 123 + it));
+
+			auto reference = ComputeAgeLatency(model);
+			auto maxplus = ComputeAgeLatencyWithEngine(model, max_plus_engine, AgeLatencyOptions::checked());
+			BOOST_CHECK_EQUAL(maxplus.age_latency, reference.age_latency);
+			BOOST_CHECK_EQUAL(maxplus.upper_bounds.front(), reference.upper_bounds.front());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_max_plus_non_topological_ids) {
+
+	check_engine_non_topological_ids(max_plus_engine);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
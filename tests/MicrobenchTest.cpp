@@ -0,0 +1,58 @@
+/*
+ * MicrobenchTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE MicrobenchTest
+#include <boost/test/unit_test.hpp>
+#include <microbench.h>
+#include <sstream>
+
+static utils::MeasureOptions single_run () {
+	utils::MeasureOptions measure;
+	measure.warmup = 0;
+	measure.target_time = 0;
+	measure.min_repetitions = 1;
+	return measure;
+}
+
+BOOST_AUTO_TEST_SUITE(MicrobenchTest)
+
+BOOST_AUTO_TEST_CASE(test_filter) {
+	const auto euclide = run_microbenchmarks("extended_euclide/", single_run());
+	BOOST_CHECK_EQUAL(euclide.size(), 6);
+	for (const MicrobenchResult& res : euclide) {
+		BOOST_CHECK(res.name.find("extended_euclide/") != std::string::npos);
+		BOOST_CHECK_GT(res.edges, 0);
+		BOOST_CHECK_EQUAL(res.executions, 0);
+		BOOST_CHECK_EQUAL(res.timing.repetitions(), 1);
+	}
+
+	const auto kernels = run_microbenchmarks("/automotive", single_run());
+	BOOST_CHECK_GE(kernels.size(), 9);
+	for (const MicrobenchResult& res : kernels) {
+		BOOST_CHECK(res.name.find("/automotive") != std::string::npos);
+		if (res.name.rfind("new_algorithm2/case", 0) == 0) BOOST_CHECK_GT(res.edges, 0);
+		if (res.name.rfind("FindLongestPath", 0) == 0) BOOST_CHECK_GT(res.executions, 0);
+	}
+
+	BOOST_CHECK(run_microbenchmarks("no such kernel", single_run()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_baseline) {
+	std::istringstream input (
+			"#     filter = \n"
+			"#  name reps median p90 edges execs ns/edge ns/exec\n"
+			"  FindLongestPath/generic      5   219.64319   221.16737    172844       968    1270.8  226904.1\n"
+			"  extended_euclide/generic  1000     0.00369     0.00375        25         0     147.7         -     0.00400    0.92\n"
+			"\n"
+			"# 0 slowdowns beyond 10.00%\n");
+	const auto baseline = read_microbench_baseline(input);
+	BOOST_REQUIRE_EQUAL(baseline.size(), 2);
+	BOOST_CHECK_CLOSE(baseline.at("FindLongestPath/generic"), 219.64319, 1e-9);
+	BOOST_CHECK_CLOSE(baseline.at("extended_euclide/generic"), 0.00369, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
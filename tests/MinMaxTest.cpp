@@ -23,7 +23,7 @@ BOOST_AUTO_TEST_CASE(test_figure1_graph) {
 	TASK_ID t1 = figure1.addTask(0, 3, 4);
 	TASK_ID t2 = figure1.addTask(1, 2, 3);
 	figure1.addDependency(t1, t2);
-	auto age_latency = ComputeAgeLatency(figure1);
+	auto age_latency = ComputeAgeLatency(figure1, generate_partial_constraint_graph, AgeLatencyOptions::checked());
 	VERBOSE_INFO ( " AGE LATENCY OF sample1 IS " << age_latency);
 
 
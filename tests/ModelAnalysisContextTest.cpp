@@ -0,0 +1,139 @@
+/*
+ * ModelAnalysisContextTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE ModelAnalysisContextTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <repetition_vector.h>
+#include <verbose.h>
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE(ModelAnalysisContextTest)
+
+BOOST_AUTO_TEST_CASE(test_context_constants) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 8, 12, 123 + it);
+			const ModelAnalysisContext context (model);
+
+			BOOST_REQUIRE_EQUAL(context.getTaskCount(), model.getTaskCount());
+			BOOST_REQUIRE_EQUAL(context.getDependencyCount(), model.getDependencyCount());
+			BOOST_CHECK_GE(context.getSetupTime(), 0);
+
+			// Same repetition vector as repetition_vector.cpp
+			BOOST_REQUIRE_GT(context.getHyperperiod(), 0);
+			BOOST_CHECK_EQUAL(context.getSumN(), compute_sum_n(model));
+			const auto N = compute_repetition_vector(model);
+			for (const Task& t : model.tasks()) {
+				BOOST_CHECK_EQUAL(context.getPeriod(t.getId()), t.getT());
+				BOOST_CHECK_EQUAL(context.getOffset(t.getId()), t.getr());
+				BOOST_CHECK_EQUAL(context.getDeadline(t.getId()), t.getD());
+				BOOST_CHECK_EQUAL(context.getN(t.getId()), N.at(t.getId()));
+			}
+
+			// Adjacency and per-dependency constants.
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+			for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) model.getDependencyCount() ; did++) {
+				const Dependency& d = model.dependencies()[did];
+				const DependencyConstants& c = context.getDependency(did);
+				BOOST_REQUIRE_EQUAL(c.ti, d.getFirst());
+				BOOST_REQUIRE_EQUAL(c.tj, d.getSecond());
+				const auto& outputs = context.getOutputs(d.getFirst());
+				const auto& inputs = context.getInputs(d.getSecond());
+				BOOST_CHECK(std::find(outputs.begin(), outputs.end(), did) != outputs.end());
+				BOOST_CHECK(std::find(inputs.begin(), inputs.end(), did) != inputs.end());
+
+				const Theorem6Kernel expected (model.getTaskById(c.ti), model.getTaskById(c.tj), K[c.ti], K[c.tj]);
+				const Theorem6Kernel kernel = context.getKernel(did, K);
+				BOOST_CHECK_EQUAL(kernel.Ti, expected.Ti);
+				BOOST_CHECK_EQUAL(kernel.Tj, expected.Tj);
+				BOOST_CHECK_EQUAL(kernel.gcdT, expected.gcdT);
+				BOOST_CHECK_EQUAL(kernel.gcdK, expected.gcdK);
+				BOOST_CHECK_EQUAL(kernel.Me, expected.Me);
+				BOOST_CHECK_EQUAL(kernel.rjmripTimTj, expected.rjmripTimTj);
+			}
+
+			// Every dependency goes forward in the order and to a higher level.
+			std::vector<size_t> position (model.getTaskCount()), level (model.getTaskCount());
+			BOOST_REQUIRE_EQUAL(context.getTopologicalOrder().size(), model.getTaskCount());
+			for (size_t i = 0 ; i < context.getTopologicalOrder().size() ; i++) position[context.getTopologicalOrder()[i]] = i;
+			for (size_t l = 0 ; l < context.getTaskLevels().size() ; l++) {
+				for (TASK_ID tid : context.getTaskLevels()[l]) level[tid] = l;
+			}
+			for (const Dependency& d : model.dependencies()) {
+				BOOST_CHECK_LT(position[d.getFirst()], position[d.getSecond()]);
+				BOOST_CHECK_LT(level[d.getFirst()], level[d.getSecond()]);
+			}
+
+			// The generators built on the context still match the reference.
+			auto reference = generate_partial_constraint_graph(model, K);
+			BOOST_REQUIRE_EQUAL(new_generate_partial_constraint_graph(model, K), reference);
+			BOOST_REQUIRE_EQUAL(opt_new_generate_partial_constraint_graph(model, K), reference);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_context) {
+
+	LETModel model = Generator::getInstance().generate(LETDatasetType::automotive_dt, 8, 12, 123);
+
+	// Every iteration expands with the context built once by ComputeAgeLatency.
+	std::vector<const ModelAnalysisContext*> contexts;
+	GenerateExpansionFun recording = [&contexts] (const ModelAnalysisContext &context, const PeriodicityVector &K) {
+		contexts.push_back(&context);
+		return opt_new_generate_partial_constraint_graph(context, K);
+	};
+	auto res = ComputeAgeLatency(model, recording, AgeLatencyOptions::production());
+	BOOST_REQUIRE_GE(res.iterations, 1);
+	BOOST_CHECK_EQUAL(contexts.size(), res.iterations);
+	for (const ModelAnalysisContext* context : contexts) BOOST_CHECK_EQUAL(context, contexts.front());
+	BOOST_CHECK_EQUAL(res.sum_n, compute_sum_n(model));
+	BOOST_CHECK_GE(res.context_setup_time, 0);
+
+	// Generators on the model still work, they are called with context.getModel().
+	GenerateExpansionFun on_model = [] (const LETModel &model, const PeriodicityVector &K) {
+		return opt_new_generate_partial_constraint_graph(model, K);
+	};
+	BOOST_CHECK_EQUAL(ComputeAgeLatency(model, on_model).age_latency, res.age_latency);
+	const PeriodicityVector K = generate_random_periodicity_vector(model, 123);
+	BOOST_CHECK_EQUAL(on_model(model, K), recording(ModelAnalysisContext(model), K));
+}
+
+BOOST_AUTO_TEST_CASE(test_hyperperiod_overflow) {
+
+	// Pairwise coprime periods whose product exceeds a long.
+	LETModel model;
+	for (INTEGER_TIME_UNIT T : {1000000007L, 1000000009L, 998244353L}) model.addTask(0, T);
+	const ModelAnalysisContext context (model);
+	BOOST_CHECK_EQUAL(context.getHyperperiod(), 0);
+	BOOST_CHECK_EQUAL(context.getSumN(), 0);
+	BOOST_CHECK_EQUAL(context.getTopologicalOrder().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_cyclic_task_graph) {
+
+	// Only the engines walking the task DAG need an order, the expansions still accept a cycle.
+	LETModel model;
+	const TASK_ID t0 = model.addTask(0, 10);
+	const TASK_ID t1 = model.addTask(0, 10);
+	model.addDependency(t0, t1);
+	model.addDependency(t1, t0);
+
+	const ModelAnalysisContext context (model);
+	BOOST_CHECK_EQUAL(context.getHyperperiod(), 10);
+
+	const PeriodicityVector K = generate_periodicity_vector(model);
+	const PartialConstraintGraph reference = generate_partial_constraint_graph(model, K);
+	BOOST_CHECK_EQUAL(reference.getConstraints().size(), 2); // every task has inputs and outputs, no start or finish
+	BOOST_CHECK_EQUAL(generate_partial_constraint_graph(context, K), reference);
+	BOOST_CHECK_EQUAL(new_generate_partial_constraint_graph(context, K), reference);
+	BOOST_CHECK_EQUAL(opt_new_generate_partial_constraint_graph(context, K), reference);
+	BOOST_CHECK_GT(generate_partial_lowerbound_graph(context, K).getConstraints().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
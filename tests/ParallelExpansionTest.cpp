@@ -0,0 +1,97 @@
+/*
+ * ParallelExpansionTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE ParallelExpansionTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include <atomic>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(ParallelExpansionTest)
+
+BOOST_AUTO_TEST_CASE(test_parallel_for) {
+
+	for (size_t thread_count : {0, 1, 3, 8}) {
+		std::vector<std::atomic<size_t>> visits (100);
+		utils::parallel_for(visits.size(), thread_count, [&visits] (size_t i) { visits[i]++; });
+		for (auto& v : visits) BOOST_CHECK_EQUAL(v.load(), 1);
+	}
+
+	BOOST_CHECK_THROW(utils::parallel_for(10, 4, [] (size_t i) { if (i == 5) throw std::runtime_error("failure"); }), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_phases) {
+
+	const std::vector<size_t> counts = {3, 0, 50, 1, 17};
+	for (size_t thread_count : {0, 1, 3, 8}) {
+		std::vector<std::vector<std::atomic<size_t>>> visits (counts.size());
+		for (size_t p = 0 ; p < counts.size() ; p++) visits[p] = std::vector<std::atomic<size_t>>(counts[p]);
+		// Every index of the previous phase is visited before a phase starts.
+		std::atomic<size_t> done (0);
+		std::atomic<bool> ordered (true);
+		utils::parallel_for_phases(counts, thread_count, [&] (size_t p, size_t i) {
+			size_t before = 0;
+			for (size_t q = 0 ; q < p ; q++) before += counts[q];
+			if (done.load() < before) ordered = false;
+			visits[p][i]++;
+			done++;
+		});
+		BOOST_CHECK(ordered.load());
+		for (auto& phase : visits) for (auto& v : phase) BOOST_CHECK_EQUAL(v.load(), 1);
+	}
+
+	BOOST_CHECK_THROW(utils::parallel_for_phases({4, 10, 4}, 4, [] (size_t p, size_t i) { if (p == 1 and i == 5) throw std::runtime_error("failure"); }), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_split_rows) {
+
+	// 64x64 executions, the dependency is split by ai ranges.
+	LETModel model;
+	auto t0 = model.addTask(0, 5);
+	auto t1 = model.addTask(1, 3);
+	auto t2 = model.addTask(2, 4);
+	model.addDependency(t0, t1);
+	model.addDependency(t1, t2);
+	model.addDependency(t0, t2);
+
+	PeriodicityVector K = {64, 64, 3};
+	auto reference = generate_partial_constraint_graph(model, K);
+
+	for (size_t thread_count : {1, 2, 4, 7}) {
+		BOOST_REQUIRE_EQUAL(parallel_generate_partial_constraint_graph(model, K, thread_count), reference);
+		BOOST_REQUIRE_EQUAL(parallel_generate_compact_constraint_graph(model, K, thread_count), reference);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_random) {
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto K = generate_random_periodicity_vector(model, 123 + it);
+
+			InstrumentationCounters::local().algorithm2.clear();
+			auto serial = opt_new_generate_partial_constraint_graph(model, K);
+			const Algorithm2_statistics serial_stats = InstrumentationCounters::local().algorithm2;
+
+			for (size_t thread_count : {2, 4}) {
+				InstrumentationCounters::local().algorithm2.clear();
+				auto parallel = parallel_expansion(thread_count)(model, K);
+				const Algorithm2_statistics& stats = InstrumentationCounters::local().algorithm2;
+				BOOST_REQUIRE_EQUAL(parallel, serial);
+				BOOST_CHECK_EQUAL(stats.total_case1, serial_stats.total_case1);
+				BOOST_CHECK_EQUAL(stats.total_case2, serial_stats.total_case2);
+				BOOST_CHECK_EQUAL(stats.total_case3, serial_stats.total_case3);
+
+				BOOST_REQUIRE_EQUAL(parallel_compact_expansion(thread_count)(model, K), serial);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/*
+ * PartialConstraintGraphTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE PartialConstraintGraphTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(PartialConstraintGraphTest)
+
+/**
+ * Upper bound graph of Theorem 6 with the double formula used before the integer kernel,
+ * an oracle that does not share any code with the generators.
+ */
+static PartialConstraintGraph double_constraint_graph (const LETModel &model, const PeriodicityVector &K) {
+	PartialConstraintGraph graph;
+	for (const Dependency& d : model.dependencies()) {
+		const Task ti = model.getTaskById(d.getFirst());
+		const Task tj = model.getTaskById(d.getSecond());
+		const INTEGER_TIME_UNIT Ti = ti.getT();
+		const INTEGER_TIME_UNIT Tj = tj.getT();
+		const INTEGER_TIME_UNIT gcdeT = std::gcd(Ti, Tj);
+		const auto gcdeK = std::gcd(Ti * K[d.getFirst()], Tj * K[d.getSecond()]);
+		const auto Me = Tj + std::ceil((ti.getr() - tj.getr() + ti.getD()) / gcdeT) * gcdeT;
+		for (EXECUTION_COUNT ai = 1 ; ai <= K[d.getFirst()] ; ai++) {
+			for (EXECUTION_COUNT aj = 1 ; aj <= K[d.getSecond()] ; aj++) {
+				const INTEGER_TIME_UNIT alphae_ai_aj = (Ti * ai - Tj * aj) / gcdeT;
+				const INTEGER_TIME_UNIT pi_min = std::ceil((-Me + gcdeT - alphae_ai_aj * gcdeT) / gcdeK);
+				const INTEGER_TIME_UNIT pi_max = std::floor((-Me + Ti - alphae_ai_aj * gcdeT) / gcdeK);
+				if (pi_min <= pi_max) {
+					const INTEGER_TIME_UNIT Lmax = tj.getr() - ti.getr() + Ti - Tj - (pi_min * gcdeK + alphae_ai_aj * gcdeT);
+					graph.add(Constraint(Execution(d.getFirst(), ai), Execution(d.getSecond(), aj), Lmax));
+				}
+			}
+		}
+	}
+	add_start_finish(model, K, graph);
+	return graph;
+}
+
+BOOST_AUTO_TEST_CASE(test_double_oracle) {
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			const LETModel model = Generator::getInstance().generate(dt, 8, 12, 321 + it);
+			const ModelAnalysisContext context (model);
+			for (const PeriodicityVector& K : {generate_unitary_periodicity_vector(model), generate_random_periodicity_vector(model, 321 + it)}) {
+				const PartialConstraintGraph oracle = double_constraint_graph(model, K);
+				BOOST_REQUIRE_EQUAL(generate_partial_constraint_graph(model, K), oracle);
+				BOOST_REQUIRE_EQUAL(opt_new_generate_partial_constraint_graph(model, K), oracle);
+				BOOST_REQUIRE_EQUAL(generate_compact_constraint_graph(model, K), oracle);
+
+				// Both add_constraints and add_lowerbounds overloads produce the same constraints.
+				PartialConstraintGraph by_dependency, by_id, lower_by_dependency, lower_by_id;
+				for (DEPENDENCY_ID did = 0 ; did < (DEPENDENCY_ID) model.getDependencyCount() ; did++) {
+					add_constraints(model, K, model.dependencies()[did], by_dependency);
+					add_constraints(context, K, did, by_id);
+					add_lowerbounds(model, K, model.dependencies()[did], lower_by_dependency);
+					add_lowerbounds(context, K, did, lower_by_id);
+				}
+				BOOST_REQUIRE_EQUAL(by_dependency, by_id);
+				BOOST_REQUIRE_EQUAL(lower_by_dependency, lower_by_id);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_views) {
+
+	LETModel model;
+	auto t0 = model.addTask(0, 5);
+	auto t1 = model.addTask(1, 2);
+	model.addDependency(t0, t1);
+
+	auto K = generate_periodicity_vector(model, 3);
+	const PartialConstraintGraph graph = generate_partial_constraint_graph(model, K);
+
+	size_t inputs = 0, outputs = 0;
+	for (const Execution& e : graph.getExecutions()) {
+		auto in = graph.getInputs(e);
+		auto out = graph.getOutputs(e);
+		BOOST_CHECK_EQUAL(in.size(), graph.getInputCount(e));
+		BOOST_CHECK_EQUAL(out.size(), graph.getOutputCount(e));
+		BOOST_CHECK_EQUAL((size_t) std::distance(in.begin(), in.end()), in.size());
+		for (const Constraint& c : in) BOOST_CHECK_EQUAL(c.getDestination(), e);
+		for (const Constraint& c : out) BOOST_CHECK_EQUAL(c.getSource(), e);
+		inputs += in.size();
+		outputs += out.size();
+	}
+	BOOST_CHECK_EQUAL(inputs, graph.getConstraints().size());
+	BOOST_CHECK_EQUAL(outputs, graph.getConstraints().size());
+
+	// Unknown executions give empty views.
+	Execution unknown (42, 1);
+	BOOST_CHECK(graph.getInputs(unknown).empty());
+	BOOST_CHECK(graph.getOutputs(unknown).empty());
+	BOOST_CHECK_EQUAL(graph.getInputCount(unknown), 0);
+	BOOST_CHECK_EQUAL(graph.getOutputCount(unknown), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_allocation_count) {
+
+	LETModel model = Generator::getInstance().generate(LETDatasetType::automotive_dt, 8, 12, 123);
+	auto K = generate_random_periodicity_vector(model, 123);
+
+	size_t before = utils::allocation_count();
+	const PartialConstraintGraph graph = generate_partial_constraint_graph(model, K);
+	const size_t generation = utils::allocation_count() - before;
+	BOOST_CHECK_GT(generation, 0);
+
+	// Read API does not allocate.
+	before = utils::allocation_count();
+	size_t degrees = 0;
+	for (const Execution& e : graph.getExecutions()) {
+		degrees += graph.getInputs(e).size() + graph.getOutputCount(e);
+	}
+	BOOST_CHECK_EQUAL(degrees, 2 * graph.getConstraints().size());
+	BOOST_CHECK_EQUAL(utils::allocation_count() - before, 0);
+
+	// The path search only allocates its working maps, far less than a copy of the graph.
+	before = utils::allocation_count();
+	FindLongestPath(graph);
+	BOOST_CHECK_LT(utils::allocation_count() - before, generation);
+
+	auto res = ComputeAgeLatency(model);
+	BOOST_CHECK_EQUAL(res.allocation_count.size(), res.upper_bounds.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+/*
+ * RefinementStrategyTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE RefinementStrategyTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+static std::vector<std::pair<std::string, RefinementStrategy>> all_strategies () {
+	return {
+		{"path", critical_path_refinement()},
+		{"neighbourhood", neighbourhood_refinement()},
+		{"small_n", small_n_refinement()},
+		{"seeded", seeded_refinement()},
+		{"speculative", speculative_refinement({critical_path_refinement(), neighbourhood_refinement(), small_n_refinement()})},
+	};
+}
+
+BOOST_AUTO_TEST_SUITE(RefinementStrategyTest)
+
+BOOST_AUTO_TEST_CASE(test_initial_divides_n) {
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 123 + it);
+		const ModelAnalysisContext context (model);
+		for (auto& strategy : all_strategies()) {
+			if (not strategy.second.initial) continue;
+			const PeriodicityVector K = strategy.second.initial(context);
+			BOOST_REQUIRE_EQUAL(K.size(), context.getTaskCount());
+			for (TASK_ID t = 0 ; t < (TASK_ID) K.size() ; t++) {
+				BOOST_CHECK_EQUAL(context.getN(t) % K[t], 0);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_same_age_latency) {
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto reference = ComputeAgeLatency(model);
+			for (auto& strategy : all_strategies()) {
+				AgeLatencyOptions options = AgeLatencyOptions::checked();
+				options.refinement = strategy.second;
+				auto res = ComputeAgeLatency(model, generate_partial_constraint_graph, options);
+				BOOST_TEST_MESSAGE(strategy.first << " iterations " << res.iterations << " vs " << reference.iterations);
+				BOOST_CHECK_EQUAL(res.age_latency, reference.age_latency);
+				BOOST_CHECK_EQUAL(res.candidate_count.size(), res.iterations);
+				BOOST_CHECK_EQUAL(res.candidate_count.front(), 1);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_speculative_threads) {
+	AgeLatencyOptions sequential;
+	sequential.refinement = speculative_refinement({critical_path_refinement(), neighbourhood_refinement(), small_n_refinement(4)});
+	AgeLatencyOptions parallel = sequential;
+	parallel.speculative_threads = 4;
+
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 456 + it);
+		auto s = ComputeAgeLatency(model, generate_partial_constraint_graph, sequential);
+		auto p = ComputeAgeLatency(model, generate_partial_constraint_graph, parallel);
+
+		BOOST_CHECK_EQUAL(s.age_latency, p.age_latency);
+		BOOST_CHECK_EQUAL(s.iterations, p.iterations);
+		BOOST_CHECK(s.upper_bounds == p.upper_bounds);
+		BOOST_CHECK(s.candidate_count == p.candidate_count);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/*
+ * TimingTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE TimingTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <cmath>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(TimingTest)
+
+BOOST_AUTO_TEST_CASE(test_statistics) {
+	const utils::TimingStatistics empty;
+	BOOST_CHECK_EQUAL(empty.repetitions(), 0);
+	BOOST_CHECK_EQUAL(empty.mean, 0);
+
+	const utils::TimingStatistics stats ({5, 1, 4, 2, 3, 10, 9, 8, 7, 6});
+	BOOST_CHECK_EQUAL(stats.repetitions(), 10);
+	BOOST_CHECK_EQUAL(stats.min, 1);
+	BOOST_CHECK_EQUAL(stats.median, 5);
+	BOOST_CHECK_EQUAL(stats.p90, 9);
+	BOOST_CHECK_CLOSE(stats.mean, 5.5, 1e-9);
+	BOOST_CHECK_CLOSE(stats.stddev, std::sqrt(8.25), 1e-9);
+
+	const utils::TimingStatistics single ({3});
+	BOOST_CHECK_EQUAL(single.median, 3);
+	BOOST_CHECK_EQUAL(single.p90, 3);
+	BOOST_CHECK_EQUAL(single.stddev, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge) {
+	const utils::TimingStatistics merged = utils::TimingStatistics({1, 2, 3}) + utils::TimingStatistics({4, 5});
+	BOOST_CHECK_EQUAL(merged.repetitions(), 5);
+	BOOST_CHECK_EQUAL(merged.min, 1);
+	BOOST_CHECK_EQUAL(merged.median, 3);
+	BOOST_CHECK_CLOSE(merged.mean, 3, 1e-9);
+	BOOST_CHECK_EQUAL((utils::TimingStatistics() + merged).repetitions(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_warmup_and_repetitions) {
+	size_t calls = 0;
+	utils::MeasureOptions options;
+	options.warmup = 3;
+	options.min_repetitions = 7;
+	const utils::TimingStatistics stats = utils::measure([&calls] () { calls++; }, options);
+	BOOST_CHECK_EQUAL(calls, 10);
+	BOOST_CHECK_EQUAL(stats.repetitions(), 7);
+	BOOST_CHECK_GE(stats.min, 0);
+	BOOST_CHECK_LE(stats.min, stats.median);
+	BOOST_CHECK_LE(stats.median, stats.p90);
+}
+
+BOOST_AUTO_TEST_CASE(test_setup) {
+	// The setup runs before every call and is not timed.
+	size_t setups = 0, calls = 0;
+	utils::MeasureOptions options;
+	options.warmup = 2;
+	options.min_repetitions = 3;
+	const utils::TimingStatistics stats = utils::measure([&calls, &setups] () {
+		BOOST_CHECK_EQUAL(setups, calls + 1);
+		calls++;
+	}, options, [&setups] () {
+		setups++;
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	});
+	BOOST_CHECK_EQUAL(setups, 5);
+	BOOST_CHECK_EQUAL(calls, 5);
+	BOOST_CHECK_LT(stats.median, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_calibration) {
+	// A function of at least 1 ms measured for about 20 ms, the first call sets the count whatever the sleep really lasted.
+	utils::MeasureOptions options;
+	options.warmup = 0;
+	options.target_time = 20;
+	const utils::TimingStatistics stats = utils::measure([] () { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }, options);
+	BOOST_CHECK_GE(stats.min, 1);
+	const size_t expected = std::max((size_t) std::ceil(options.target_time / stats.times.front()), options.min_repetitions);
+	BOOST_CHECK_EQUAL(stats.repetitions(), std::min(expected, options.max_repetitions));
+	BOOST_CHECK_LE(stats.repetitions(), 20);
+
+	// The calibration stays within the repetition bounds.
+	options.max_repetitions = 3;
+	BOOST_CHECK_EQUAL(utils::measure([] () {}, options).repetitions(), 3);
+	options.min_repetitions = 5;
+	BOOST_CHECK_EQUAL(utils::measure([] () {}, options).repetitions(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_elapsed_ms) {
+	const utils::TimePoint start = utils::now();
+	std::this_thread::sleep_for(std::chrono::microseconds(300));
+	const double elapsed = utils::elapsed_ms(start);
+	// Sub-millisecond durations are not truncated.
+	BOOST_CHECK_GT(elapsed, 0.29);
+	BOOST_CHECK_GE(utils::elapsed_ms(start, utils::now()), elapsed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+/*
+ * WarmStartTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: toky
+ */
+
+#define BOOST_TEST_MODULE WarmStartTest
+#include <boost/test/unit_test.hpp>
+#include <letitgo.h>
+#include <verbose.h>
+
+static AgeLatencyOptions warm_start_from (const AgeLatencyResult& previous) {
+	AgeLatencyOptions options;
+	options.warm_start_K = previous.periodicity_vector;
+	options.warm_start_path = previous.critical_path;
+	return options;
+}
+
+BOOST_AUTO_TEST_SUITE(WarmStartTest)
+
+BOOST_AUTO_TEST_CASE(test_shift_task_offset) {
+	LETModel model = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 123);
+	LETModel shifted = shift_task_offset(model, 3, 2);
+	BOOST_REQUIRE_EQUAL(shifted.getTaskCount(), model.getTaskCount());
+	BOOST_REQUIRE_EQUAL(shifted.getDependencyCount(), model.getDependencyCount());
+	for (TASK_ID t = 0 ; t < (TASK_ID) model.getTaskCount() ; t++) {
+		BOOST_CHECK_EQUAL(shifted.getTaskById(t).getr(), model.getTaskById(t).getr() + ((t == 3) ? 2 : 0));
+		BOOST_CHECK_EQUAL(shifted.getTaskById(t).getT(), model.getTaskById(t).getT());
+	}
+	BOOST_CHECK(shifted.dependencies() == model.dependencies());
+}
+
+BOOST_AUTO_TEST_CASE(test_same_model) {
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto cold = ComputeAgeLatency(model);
+			BOOST_REQUIRE_EQUAL(cold.periodicity_vector.size(), model.getTaskCount());
+			BOOST_REQUIRE_GE(cold.critical_path.size(), 2);
+
+			// The final K already satisfies its own critical path.
+			auto warm = ComputeAgeLatency(model, generate_partial_constraint_graph, warm_start_from(cold));
+			BOOST_CHECK_EQUAL(warm.age_latency, cold.age_latency);
+			BOOST_CHECK_EQUAL(warm.iterations, 1);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_perturbed_model) {
+	size_t cold_iterations = 0, warm_iterations = 0;
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		for (LETDatasetType dt : {LETDatasetType::automotive_dt, LETDatasetType::harmonic_dt, LETDatasetType::generic_dt}) {
+			LETModel model = Generator::getInstance().generate(dt, 10, 20, 123 + it);
+			auto previous = ComputeAgeLatency(model);
+
+			LETModel perturbed = shift_task_offset(model, it % model.getTaskCount(), 1);
+			auto cold = ComputeAgeLatency(perturbed, generate_partial_constraint_graph, AgeLatencyOptions::checked());
+			auto warm = ComputeAgeLatency(perturbed, generate_partial_constraint_graph, warm_start_from(previous));
+			BOOST_CHECK_EQUAL(warm.age_latency, cold.age_latency);
+			cold_iterations += cold.iterations;
+			warm_iterations += warm.iterations;
+		}
+	}
+	BOOST_TEST_MESSAGE("Iterations cold=" << cold_iterations << " warm=" << warm_iterations);
+	BOOST_CHECK_LT(warm_iterations, cold_iterations);
+}
+
+BOOST_AUTO_TEST_CASE(test_changed_model) {
+	// A warm start from another model must not change the answer, only the iterations.
+	for (size_t it = 0 ; it < 10 ; it ++ ) {
+		LETModel first = Generator::getInstance().generate(LETDatasetType::generic_dt, 10, 20, 123 + it);
+		LETModel second = Generator::getInstance().generate(LETDatasetType::generic_dt, 8, 14, 456 + it);
+		auto previous = ComputeAgeLatency(first);
+		auto cold = ComputeAgeLatency(second);
+		auto warm = ComputeAgeLatency(second, generate_partial_constraint_graph, warm_start_from(previous));
+		BOOST_CHECK_EQUAL(warm.age_latency, cold.age_latency);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()